@@ -0,0 +1,153 @@
+// AUTHOR:   Jacobie Fullerton
+// FILENAME: ArrivalIndex.h
+// DATE:     11/11/2023
+// PURPOSE:  Defines the ArrivalIndex class, which maps the arrival number
+//           given to each patient when they were added to their slot in the
+//           heap, and counts the patients still waiting that arrived before
+//           a given patient.
+// INPUT:    The arrival number of the patient in each heap slot, and the
+//           slots that are swapped, appended or removed.
+// PROCESS:  Keeps the slot of every arrival number in a vector and the
+//           arrivals still waiting in a Fenwick tree, so a patient's place
+//           in arrival order can be found in logarithmic time.
+// OUTPUT:   The place in arrival order of a patient, and the heap slot of
+//           the patient at a place in arrival order.
+
+#ifndef P3_ARRIVALINDEX_H
+#define P3_ARRIVALINDEX_H
+
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+class ArrivalIndex {
+public:
+    // Constructor
+    ArrivalIndex();
+
+    // Adds the patient in the slot after the last one to the index
+    // Precondition: arrival >= 1 and is not already waiting
+    // Postcondition: The new last slot is indexed under the arrival
+    void push(int arrival);
+
+    // Removes the patient in the last slot from the index
+    // Precondition: The index is not empty
+    // Postcondition: The arrival of the last slot is no longer waiting
+    void pop();
+
+    // Exchanges the patients indexed for two slots
+    // Precondition: Both slots are indexed
+    // Postcondition: Each slot is indexed under the other's arrival
+    void swap(int first, int second);
+
+    // Returns the place in arrival order of a waiting patient, the patient
+    // who arrived first among those waiting is at place 1
+    // Precondition: The arrival is waiting
+    // Postcondition: Returns the place, in O(log n)
+    int getPlace(int arrival) const;
+
+    // Returns the heap slot of the patient at a place in arrival order
+    // Precondition: none
+    // Postcondition: Returns the slot in O(log n), or -1 if no patient is
+    // at that place
+    int getSlotAtPlace(int place) const;
+
+private:
+    vector<int> slots;    // Heap slot of each arrival number, -1 if gone
+    vector<int> arrivals; // Arrival number of the patient in each slot
+    vector<int> tree;     // Fenwick tree counting waiting arrivals
+
+    // Adds delta to the count of an arrival in the Fenwick tree
+    // Precondition: The arrival fits in the tree
+    // Postcondition: Prefix counts including the arrival are updated
+    void update(int arrival, int delta);
+
+    // Grows the index so it can hold the given arrival number
+    // Precondition: none
+    // Postcondition: The tree size is a power of two greater than arrival
+    void reserve(int arrival);
+};
+
+// Constructor
+ArrivalIndex::ArrivalIndex() : slots(16, -1), tree(16, 0) {
+}
+
+// Adds the patient in the slot after the last one to the index
+void ArrivalIndex::push(int arrival) {
+    reserve(arrival);
+    slots[arrival] = static_cast<int>(arrivals.size());
+    arrivals.push_back(arrival);
+    update(arrival, 1);
+}
+
+// Removes the patient in the last slot from the index
+void ArrivalIndex::pop() {
+    int arrival = arrivals.back();
+    slots[arrival] = -1;
+    arrivals.pop_back();
+    update(arrival, -1);
+}
+
+// Exchanges the patients indexed for two slots
+void ArrivalIndex::swap(int first, int second) {
+    std::swap(arrivals[first], arrivals[second]);
+    slots[arrivals[first]] = first;
+    slots[arrivals[second]] = second;
+}
+
+// Returns the place in arrival order of a waiting patient
+int ArrivalIndex::getPlace(int arrival) const {
+    int place = 0;
+    for (int i = arrival; i > 0; i -= i & -i) {
+        place += tree[i];
+    }
+    return place;
+}
+
+// Returns the heap slot of the patient at a place in arrival order
+int ArrivalIndex::getSlotAtPlace(int place) const {
+    if (place < 1 || place > static_cast<int>(arrivals.size()))
+        return -1;
+
+    // Descends the tree, skipping whole ranges that arrived earlier
+    int arrival = 0;
+    for (int step = static_cast<int>(tree.size()) / 2; step > 0; step /= 2) {
+        if (arrival + step < static_cast<int>(tree.size()) &&
+            tree[arrival + step] < place) {
+            arrival += step;
+            place -= tree[arrival];
+        }
+    }
+    return slots[arrival + 1];
+}
+
+// Adds delta to the count of an arrival in the Fenwick tree
+void ArrivalIndex::update(int arrival, int delta) {
+    for (int i = arrival; i < static_cast<int>(tree.size()); i += i & -i) {
+        tree[i] += delta;
+    }
+}
+
+// Grows the index so it can hold the given arrival number
+void ArrivalIndex::reserve(int arrival) {
+    if (arrival < static_cast<int>(tree.size()))
+        return;
+
+    size_t size = tree.size();
+    while (static_cast<int>(size) <= arrival) {
+        size *= 2;
+    }
+    slots.resize(size, -1);
+
+    // Rebuilds the tree in linear time from the waiting arrivals
+    tree.assign(size, 0);
+    for (size_t i = 1; i < size; i++) {
+        tree[i] += slots[i] != -1;
+        size_t parent = i + (i & -i);
+        if (parent < size)
+            tree[parent] += tree[i];
+    }
+}
+
+#endif //P3_ARRIVALINDEX_H
@@ -0,0 +1,282 @@
+// AUTHOR:   Jacobie Fullerton
+// FILENAME: NameIndex.h
+// DATE:     11/11/2023
+// PURPOSE:  Defines the NameIndex class, a hash table that maps the names of
+//           patients, ignoring case, to their slots in the heap so patients
+//           can be found without searching the whole queue.
+// INPUT:    The name of the patient written to each heap slot, and the
+//           slots that are swapped, appended or removed.
+// PROCESS:  Stores one cell per distinct name hash in an open addressing
+//           table with linear probing. Each cell holds the first slot of a
+//           doubly linked chain through the slots of all patients whose
+//           names have that hash, so patients sharing a name cost the same
+//           to index as patients with unique names. The table size is a
+//           power of two kept at most half full, so it holds 2d to 4d cells
+//           of 8 bytes for d distinct names, plus 12 bytes per heap slot for
+//           the hash and chain links: 28 to 44 bytes per patient when every
+//           name is different, and about 12 when they all match.
+// OUTPUT:   The heap slots of all patients with a given name.
+
+#ifndef P3_NAMEINDEX_H
+#define P3_NAMEINDEX_H
+
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Patient.h"
+
+using namespace std;
+
+class NameIndex {
+public:
+    // Constructor
+    NameIndex();
+
+    // Adds the patient in the slot after the last one to the index
+    // Precondition: none
+    // Postcondition: The new last slot is indexed under the name
+    void push(const string& name);
+
+    // Removes the patient in the last slot from the index
+    // Precondition: The index is not empty
+    // Postcondition: The last slot is no longer indexed
+    void pop();
+
+    // Replaces the name indexed for a slot
+    // Precondition: The slot is indexed
+    // Postcondition: The slot is indexed under the new name
+    void assign(int slot, const string& name);
+
+    // Exchanges the patients indexed for two slots
+    // Precondition: Both slots are indexed
+    // Postcondition: Each slot is indexed under the other's name
+    void swap(int first, int second);
+
+    // Returns the slots of all patients with the name, ignoring case
+    // Precondition: heap holds the patients the index was built from
+    // Postcondition: Returns the matching slots in no particular order
+    vector<int> find(const string& name, const vector<Patient>& heap) const;
+
+private:
+    // A table entry, empty cells have a head of -1
+    struct Cell {
+        uint32_t hash;
+        int32_t head; // First slot of the chain of names with this hash
+    };
+
+    // The links of a heap slot within the chain of its hash
+    struct Link {
+        int32_t prev; // Previous slot in the chain, -1 at the head
+        int32_t next; // Next slot in the chain, -1 at the end
+    };
+
+    vector<Cell> cells;      // Table with a power of two size
+    size_t used;             // Number of cells that are not empty
+    vector<uint32_t> hashes; // Hash of the name in each heap slot
+    vector<Link> links;      // Chain links of each heap slot
+
+    // Returns the hash of a name with upper case letters folded to lower
+    // Precondition: none
+    // Postcondition: Returns the same hash for names that differ only in case
+    static uint32_t hashName(const string&);
+
+    // Returns whether two names are equal, ignoring case
+    // Precondition: none
+    // Postcondition: Returns true if the names match
+    static bool sameName(const string&, const string&);
+
+    // Returns the cell that holds the given hash
+    // Precondition: none
+    // Postcondition: Returns the position of the cell in the table, or of
+    // the empty cell where it would go
+    size_t locate(uint32_t hash) const;
+
+    // Adds a slot to the chain of its hash, creating the cell if needed
+    // Precondition: hashes holds the hash of the slot
+    // Postcondition: The slot is the head of the chain of its hash
+    void link(int slot);
+
+    // Removes a slot from the chain of its hash, removing the cell once
+    // the chain is empty
+    // Precondition: The slot is linked
+    // Postcondition: The slot is in no chain
+    void unlink(int slot);
+
+    // Removes a cell, moving later cells of the same run back into the gap
+    // Precondition: The cell is not empty
+    // Postcondition: The cell is removed and every cell is still reachable
+    void erase(size_t);
+
+    // Doubles the size of the table
+    // Precondition: none
+    // Postcondition: All cells are in the larger table
+    void grow();
+};
+
+// Constructor
+NameIndex::NameIndex() : cells(16, Cell{0, -1}), used(0) {
+}
+
+// Adds the patient in the slot after the last one to the index
+void NameIndex::push(const string& name) {
+    hashes.push_back(hashName(name));
+    links.push_back(Link{-1, -1});
+    link(static_cast<int>(hashes.size()) - 1);
+}
+
+// Removes the patient in the last slot from the index
+void NameIndex::pop() {
+    unlink(static_cast<int>(hashes.size()) - 1);
+    hashes.pop_back();
+    links.pop_back();
+}
+
+// Replaces the name indexed for a slot
+void NameIndex::assign(int slot, const string& name) {
+    uint32_t hash = hashName(name);
+    if (hash == hashes[slot])
+        return;
+
+    unlink(slot);
+    hashes[slot] = hash;
+    link(slot);
+}
+
+// Exchanges the patients indexed for two slots
+void NameIndex::swap(int first, int second) {
+    // Chains are unordered, so slots with the same hash need no change
+    if (hashes[first] == hashes[second])
+        return;
+
+    // The slots are in different chains, so neither links to the other
+    std::swap(hashes[first], hashes[second]);
+    std::swap(links[first], links[second]);
+    for (int slot : {first, second}) {
+        if (links[slot].prev == -1)
+            cells[locate(hashes[slot])].head = slot;
+        else
+            links[links[slot].prev].next = slot;
+        if (links[slot].next != -1)
+            links[links[slot].next].prev = slot;
+    }
+}
+
+// Returns the slots of all patients with the name, ignoring case
+vector<int> NameIndex::find(const string& name,
+                            const vector<Patient>& heap) const {
+    vector<int> slots;
+    for (int slot = cells[locate(hashName(name))].head; slot != -1;
+         slot = links[slot].next) {
+        if (sameName(heap[slot].getName(), name))
+            slots.push_back(slot);
+    }
+    return slots;
+}
+
+// Returns the hash of a name with upper case letters folded to lower
+uint32_t NameIndex::hashName(const string& name) {
+    // FNV-1a followed by a final mix so the low bits are well spread
+    uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash ^= (unsigned char) tolower((unsigned char) c);
+        hash *= 16777619u;
+    }
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    return hash;
+}
+
+// Returns whether two names are equal, ignoring case
+bool NameIndex::sameName(const string& first, const string& second) {
+    if (first.length() != second.length())
+        return false;
+
+    for (size_t i = 0; i < first.length(); i++) {
+        if (tolower((unsigned char) first[i]) !=
+            tolower((unsigned char) second[i]))
+            return false;
+    }
+    return true;
+}
+
+// Returns the cell that holds the given hash
+size_t NameIndex::locate(uint32_t hash) const {
+    size_t mask = cells.size() - 1;
+    size_t i = hash & mask;
+    while (cells[i].head != -1 && cells[i].hash != hash) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+// Adds a slot to the chain of its hash, creating the cell if needed
+void NameIndex::link(int slot) {
+    size_t i = locate(hashes[slot]);
+    if (cells[i].head == -1) {
+        // Keeps the table at most half full so probe runs stay short
+        if ((used + 1) * 2 > cells.size()) {
+            grow();
+            i = locate(hashes[slot]);
+        }
+        cells[i].hash = hashes[slot];
+        used++;
+    } else {
+        links[cells[i].head].prev = slot;
+    }
+    links[slot] = Link{-1, cells[i].head};
+    cells[i].head = slot;
+}
+
+// Removes a slot from the chain of its hash
+void NameIndex::unlink(int slot) {
+    Link link = links[slot];
+    if (link.next != -1)
+        links[link.next].prev = link.prev;
+
+    if (link.prev != -1) {
+        links[link.prev].next = link.next;
+    } else {
+        size_t i = locate(hashes[slot]);
+        cells[i].head = link.next;
+        if (link.next == -1) {
+            erase(i);
+            used--;
+        }
+    }
+    links[slot] = Link{-1, -1};
+}
+
+// Removes a cell, moving later cells of the same run back into the gap
+void NameIndex::erase(size_t gap) {
+    size_t mask = cells.size() - 1;
+    size_t i = gap;
+
+    while (true) {
+        i = (i + 1) & mask;
+        if (cells[i].head == -1)
+            break;
+
+        // A cell may fill the gap only if its home is not between the gap
+        // and the cell itself
+        size_t home = cells[i].hash & mask;
+        if (((i - home) & mask) >= ((i - gap) & mask)) {
+            cells[gap] = cells[i];
+            gap = i;
+        }
+    }
+    cells[gap] = Cell{0, -1};
+}
+
+// Doubles the size of the table
+void NameIndex::grow() {
+    vector<Cell> old(cells.size() * 2, Cell{0, -1});
+    old.swap(cells);
+    for (const Cell& cell : old) {
+        if (cell.head != -1)
+            cells[locate(cell.hash)] = cell;
+    }
+}
+
+#endif //P3_NAMEINDEX_H
@@ -3,10 +3,10 @@
 // DATE:     11/11/2023
 // PURPOSE:  Defines the Patient class, which encapsulates logic for storing,
 //           sorting, and printing patient information. Overloaded operators
-//           facilitate patient sorting, and an enumerator is utilized to
-//           convert priority values to strings.
-// INPUT:    Patient object, name, priority code as an integer, and arrival
-//           time as an integer.
+//           facilitate patient sorting. Priority names come from the
+//           triage scale of the queue.
+// INPUT:    Patient object, name, priority code as an integer, arrival
+//           time as an integer, and the time the patient was enqueued.
 // PROCESS:  Handles the storage and sorting of patient values, and provides
 //           comparison logic based on priority code and arrival time.
 // OUTPUT:   String representation of the Patient object.
@@ -14,6 +14,7 @@
 #ifndef P3_PATIENT_H
 #define P3_PATIENT_H
 
+#include <chrono>
 #include <string>
 #include <sstream>
 #include <iostream>
@@ -23,8 +24,10 @@ using namespace std;
 
 class Patient {
 public:
-    // Constructor
-    Patient(const string& name, int priorityCode, int arrivalTime);
+    // Constructor, the enqueue time defaults to the current time
+    Patient(const string& name, int priorityCode, int arrivalTime,
+            chrono::steady_clock::time_point enqueueTime =
+                    chrono::steady_clock::now());
 
     // Destructor
     ~Patient();
@@ -58,9 +61,22 @@ public:
     // Postcondition:Returns arrival time
     int getArrivalTime() const;
 
+    // Returns the time the patient was added to the queue
+    // Precondition: none
+    // Postcondition: Returns the monotonic enqueue time
+    chrono::steady_clock::time_point getEnqueueTime() const;
+
     // Setters
 
-    void decrementArrival();
+    // Sets the priority code of the patient
+    // Precondition: none
+    // Postcondition: Patient has the new priority code
+    void setPriorityCode(int);
+
+    // Sets the arrival time of the patient
+    // Precondition: none
+    // Postcondition: Patient has the new arrival time
+    void setArrivalTime(int);
 
     // To string
     string to_string() const;
@@ -69,16 +85,15 @@ private:
     string name;
     int priorityCode;
     int arrivalTime;
-
-    // Holds string representations of the priority codes
-    enum Priority { Immediate = 1, Emergency = 2, Urgent = 3, Minimal = 4 };
+    chrono::steady_clock::time_point enqueueTime;
 };
 
 // Constructor
 Patient::Patient(const string& nameInput, int priorityCodeInput,
-                 int arrivalTimeInput)
+                 int arrivalTimeInput,
+                 chrono::steady_clock::time_point enqueueTimeInput)
         : name(nameInput), priorityCode(priorityCodeInput),
-          arrivalTime(arrivalTimeInput) {
+          arrivalTime(arrivalTimeInput), enqueueTime(enqueueTimeInput) {
 }
 
 Patient::~Patient(){}
@@ -98,9 +113,19 @@ int Patient::getArrivalTime() const {
     return arrivalTime;
 }
 
-// Decreases patient's arrival time by 1
-void Patient::decrementArrival() {
-    --arrivalTime;
+// EnqueueTime getter
+chrono::steady_clock::time_point Patient::getEnqueueTime() const {
+    return enqueueTime;
+}
+
+// PriorityCode setter
+void Patient::setPriorityCode(int priorityCodeInput) {
+    priorityCode = priorityCodeInput;
+}
+
+// ArrivalTime setter
+void Patient::setArrivalTime(int arrivalTimeInput) {
+    arrivalTime = arrivalTimeInput;
 }
 
 // Returns the patient as a string
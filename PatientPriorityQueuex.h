@@ -4,6 +4,14 @@
 // PURPOSE:  Defines the PatientPriorityQueuex class that creates and manages
 //           a heap of patients using a vector. The overloaded operators are
 //           used to sort a vector containing the patients into heap order.
+//           Every write to the heap is recorded so that each change creates
+//           a numbered version of the queue that can be shown or undone.
+//           The wait of each removed patient is added to running metrics,
+//           and indexes of names and arrival numbers to heap slots are kept
+//           alongside the heap.
+//           Changes since the last save are kept as commands so that a save
+//           can append them instead of rewriting the whole queue.
+//           The queue is built for a triage scale chosen when compiling.
 // INPUT:    Patients can be added to the heap using the add methods.
 // PROCESS:  Upon adding, removing, or modifying patients, the heap is
 //           reordered.
@@ -13,13 +21,21 @@
 #ifndef P3_PATIENTPRIORITYQUEUE_H
 #define P3_PATIENTPRIORITYQUEUE_H
 
+#include <algorithm>
 #include <cassert>
 #include <sstream>
+#include <utility>
 #include <vector>
 #include <iomanip>
 #include "Patient.h"
-
-// Class representing a priority queue of patients
+#include "ArrivalIndex.h"
+#include "NameIndex.h"
+#include "TriageScale.h"
+#include "WaitMetrics.h"
+
+// Class representing a priority queue of patients, with priority codes
+// from the given triage scale
+template <class Scale>
 class PatientPriorityQueuex {
 public:
     // Constructor
@@ -28,16 +44,33 @@ public:
     // Destructor
     ~PatientPriorityQueuex();
 
-    // Adds a patient to the priority queue
+    // Adds a patient to the priority queue, giving them the next arrival
+    // number in place of their arrival time
     // Precondition: none
     // Postcondition: Patient is added to the priority queue
     void add(const Patient&);
 
+    // Adds many patients to the priority queue as a single change, building
+    // the heap once instead of sifting up each patient. Patients are given
+    // arrival numbers in the order of the vector.
+    // Precondition: none
+    // Postcondition: Patients are moved into the priority queue
+    void addAll(vector<Patient>&);
+
     // Removes the highest priority patient from the priority queue
     // Precondition: Priority queue is not empty
-    // Postcondition: Highest priority patient is removed from the priority queue
+    // Postcondition: Highest priority patient is removed from the priority
+    // queue and their wait is added to the metrics
     void remove();
 
+    // Removes the patient at the given place in arrival order among the
+    // patients waiting without seeing them. Saved files use this to replay
+    // a next, so loading them leaves the metrics untouched.
+    // Precondition: none
+    // Postcondition: Removes the patient, returns a string detailing the
+    // removal
+    string remove(int);
+
     // Returns the current size of the priority queue
     // Precondition: none
     // Postcondition: Returns the current size of the priority queue
@@ -59,15 +92,183 @@ public:
     // Postcondition: Returns a lines of strings that comprise the queue
     string save();
 
-    // Changes the priority of a patient in the priority queue
+    // Converts the changes made since the last save to the commands that
+    // replay them on the saved queue, each on a new line, if they can be
+    // appended to the given file of the given size in bytes
+    // Precondition: none
+    // Postcondition: Returns false if the file is not the one last saved
+    // as it was left, or the changes can only be saved by exporting the
+    // whole queue with save()
+    bool saveChanges(const string&, long long, string&) const;
+
+    // Marks the current queue as saved to the given file, after the given
+    // number of bytes were appended to it or written as a full save
+    // Precondition: The queue was just written out by save() or by
+    // appending the changes from saveChanges()
+    // Postcondition: There are no unsaved changes
+    void markSaved(const string&, long long, bool);
+
+    // Changes the priority of the patient at the given place in arrival
+    // order among the patients waiting
     // Precondition: none
     // Postcondition: Changes the patient, returns a string detailing
     // the change
     string change(int, int);
 
+    // Changes the priority of the patient with the given name, ignoring case
+    // Precondition: none
+    // Postcondition: Changes the patient if exactly one has the name,
+    // returns a string detailing the change
+    string changeByName(const string&, int);
+
+    // Finds the patients with the given name, ignoring case
+    // Precondition: none
+    // Postcondition: Returns a string detailing each matching patient
+    string find(const string&) const;
+
+    // Returns the number of the current version of the queue. Version 0 is
+    // the empty queue and every change creates the next version.
+    // Precondition: none
+    // Postcondition: Returns the current version number
+    int version() const;
+
+    // Reverts the most recent change that has not already been undone. The
+    // undo itself is recorded as a new version so earlier versions remain
+    // available. Takes O(log n) for an add, next or change, and O(k) for an
+    // import of k patients.
+    // Precondition: none
+    // Postcondition: Returns false if there was nothing left to undo
+    bool undo();
+
+    // Converts the priority queue as it was at the given version to a
+    // formatted string for display. Starts from the nearest checkpoint
+    // after the version and rewinds at most about max(1024, n) writes, so
+    // it takes O(n log n) for a queue of n patients no matter how long ago
+    // the version was. Listing n patients already takes O(n).
+    // Precondition: 0 <= version <= version()
+    // Postcondition: Returns a string representation of that version
+    string to_string(int version) const;
+
+    // Converts the wait time metrics of each priority code to a formatted
+    // string for display, without visiting the patients in the queue
+    // Precondition: none
+    // Postcondition: Returns a table of the wait time metrics
+    string metrics() const;
+
 private:
+    // A single write to the heap. Replaying writes backwards restores any
+    // earlier version of the queue.
+    struct Edit {
+        enum Kind { Assign, Swap, Push, Pop, Serve };
+
+        Kind kind;
+        int first;  // Assign: slot, Swap: slot, Serve: priority code
+        int second; // Assign/Pop: index into overwritten, Swap: slot,
+                    // Serve: index into waits
+        int delta;  // Serve: 1 if the wait was recorded, -1 if retracted
+    };
+
+    // Width of the priority code column when displaying the queue
+    static constexpr int LABEL_WIDTH = getPriorityLabelWidth<Scale>(13);
+
     vector<Patient> data; // Vector to store patient data
     int heapSize;         // Size of the priority queue
+    NameIndex names;      // Heap slots of the patients by name
+    ArrivalIndex arrivals; // Heap slots of the patients by arrival number
+    int nextArrival;      // Arrival number given to the next patient added
+
+    vector<Edit> history;         // Every write made to the heap, in order
+    vector<Patient> overwritten;  // Patients replaced by Assign or Pop writes
+    vector<size_t> versionEnd;    // Length of history at the end of a version
+    vector<int> versionSame;      // Earliest version with the same contents
+
+    // Copies of the heap at some versions, taken once max(1024, n) writes
+    // were made since the last one so memory grows with the writes
+    vector<pair<int, vector<Patient>>> checkpoints;
+    size_t checkpointEnd;         // Length of history at the last checkpoint
+
+    vector<pair<int, string>> unsaved;  // Version and command of each change
+                                        // since the last save
+    bool unsavedReplayable;             // Whether unsaved holds every change
+
+    string savedFile;         // File written by the last save
+    long long savedBaseBytes; // Size of the full queue at the start of it
+    long long savedFileBytes; // Size of the file with appended changes
+
+    // Appended changes are compacted into a full save once they grow past
+    // this size or half the size of the full queue, whichever is larger
+    static constexpr long long MIN_COMPACT_BYTES = 1 << 16;
+
+    WaitMetrics<Scale::LEVELS> waitMetrics; // Waits of the patients seen
+    vector<chrono::nanoseconds> waits;      // Waits referenced by Serve writes
+
+    // Changes the priority of the patient at the given slot
+    // Precondition: 0 <= slot < size()
+    // Postcondition: Patient is changed and the heap is reordered, returns
+    // a string detailing the change
+    string changeAt(int, int);
+
+    // Removes the patient at the given slot and reorders the heap
+    // Precondition: 0 <= slot < size()
+    // Postcondition: Patient is removed without being seen
+    void removeAt(int);
+
+    // Records the command that replays the change being made, unless there
+    // are so many changes that saving the whole queue is cheaper
+    // Precondition: none
+    // Postcondition: The command is kept until the next save
+    void recordCommand(const string&);
+
+    // Recorded heap writes
+
+    // Replaces the patient at the given slot
+    // Precondition: 0 <= slot < size(), patient has the same arrival time
+    // as the patient replaced
+    // Postcondition: Patient is stored at the slot and the write is recorded
+    void assign(int, Patient);
+
+    // Exchanges the patients at the two given slots
+    // Precondition: Both slots are less than size()
+    // Postcondition: Patients are swapped and the write is recorded
+    void swapSlots(int, int);
+
+    // Appends a patient to the end of the heap
+    // Precondition: none
+    // Postcondition: Patient is the last element and the write is recorded
+    void pushSlot(Patient);
+
+    // Removes the last patient of the heap
+    // Precondition: Priority queue is not empty
+    // Postcondition: Last patient is removed and the write is recorded
+    void popSlot();
+
+    // Records or retracts the wait of a seen patient in the metrics
+    // Precondition: A retracted wait was recorded with the same priority
+    // Postcondition: Metrics are updated and the write is recorded
+    void serve(int, chrono::nanoseconds, int);
+
+    // Applies the opposite of a recorded write to the heap
+    // Precondition: The heap is in the state right after the write
+    // Postcondition: The write is undone and the undo is itself recorded
+    void revert(Edit);
+
+    // Applies the opposite of a recorded write to a copy of the heap
+    // Precondition: The copy is in the state right after the write
+    // Postcondition: The write is undone on the copy
+    void revert(vector<Patient>&, const Edit&) const;
+
+    // Marks the end of the current version
+    // Precondition: none
+    // Postcondition: A new version holding the writes since the last one is
+    // created, with the same contents as the given version, and the heap is
+    // copied to a checkpoint if enough writes were made since the last one
+    void commitVersion(int);
+
+    // Converts a heap to a formatted string for display, showing each
+    // patient's place in arrival order among the patients in the heap
+    // Precondition: none
+    // Postcondition: Returns a string representation of the heap
+    static string listHeap(const vector<Patient>&);
 
     // Sorting helper methods
 
@@ -106,7 +307,7 @@ private:
     // Returns the value of the priority code as a string
     // Precondition: none
     // Postcondition: Returns a string representing the priority code
-    static string getPriorityString(int priority);
+    static string_view getPriorityString(int priority);
 
     // Sorts the queue by arrival number in ascending order
     // Precondition: none
@@ -115,70 +316,296 @@ private:
 };
 
 // Constructor
-PatientPriorityQueuex::PatientPriorityQueuex() {
+template <class Scale>
+PatientPriorityQueuex<Scale>::PatientPriorityQueuex() {
     heapSize = 0;
+    nextArrival = 1;
+    checkpointEnd = 0;
+    unsavedReplayable = true;
+    savedBaseBytes = 0;
+    savedFileBytes = 0;
+    versionEnd.push_back(0);
+    versionSame.push_back(0);
 }
 
 // Destructor
-PatientPriorityQueuex::~PatientPriorityQueuex() {
+template <class Scale>
+PatientPriorityQueuex<Scale>::~PatientPriorityQueuex() {
 }
 
 // Adds a patient to the priority queue
-void PatientPriorityQueuex::add(const Patient& patient) {
-    heapSize++;
-    data.push_back(patient);
+template <class Scale>
+void PatientPriorityQueuex<Scale>::add(const Patient& patient) {
+    recordCommand("add " + string(getPriorityString(patient.getPriorityCode())) +
+                  " " + patient.getName());
+    Patient admitted = patient;
+    admitted.setArrivalTime(nextArrival++);
+    pushSlot(admitted);
     siftUp(heapSize - 1);
+    commitVersion(version() + 1);
 }
 
-void PatientPriorityQueuex::remove() {
+// Adds many patients to the priority queue as a single change
+template <class Scale>
+void PatientPriorityQueuex<Scale>::addAll(vector<Patient>& patients) {
+    if (patients.empty())
+        return;
+
+    // A large import is cheaper to save as a whole queue than as commands
+    if (unsaved.size() + patients.size() > max<size_t>(1024, heapSize)) {
+        unsaved.clear();
+        unsavedReplayable = false;
+    }
+
+    int existing = heapSize;
+    for (Patient& patient : patients) {
+        if (unsavedReplayable) {
+            recordCommand("add " +
+                          string(getPriorityString(patient.getPriorityCode())) +
+                          " " + patient.getName());
+        }
+        patient.setArrivalTime(nextArrival++);
+        pushSlot(std::move(patient));
+    }
+
+    if (static_cast<int>(patients.size()) < existing) {
+        // Few patients compared to the queue, sifting each up is cheaper
+        for (int i = existing; i < heapSize; i++) {
+            siftUp(i);
+        }
+    } else {
+        // Builds the heap bottom up in linear time
+        for (int i = heapSize / 2 - 1; i >= 0; i--) {
+            siftDown(i);
+        }
+    }
+    commitVersion(version() + 1);
+}
+
+template <class Scale>
+void PatientPriorityQueuex<Scale>::remove() {
     assert(heapSize != 0);
 
-    // Decrements the arrival time of all patients after the removed patient
-    for (int i = 0; i < heapSize; i++) {
-        if (data[i].getArrivalTime() > data[0].getArrivalTime()) {
-            data[i].decrementArrival();
+    // Replaying the removal must not add a second wait to the metrics
+    recordCommand("remove " +
+                  std::to_string(arrivals.getPlace(data[0].getArrivalTime())));
+    serve(data[0].getPriorityCode(),
+          chrono::steady_clock::now() - data[0].getEnqueueTime(), 1);
+
+    removeAt(0);
+    commitVersion(version() + 1);
+}
+
+template <class Scale>
+string PatientPriorityQueuex<Scale>::remove(int arrivalID) {
+    int slot = arrivals.getSlotAtPlace(arrivalID);
+    if (slot == -1)
+        return "Patient with given id was not found.";
+
+    string name = data[slot].getName();
+    recordCommand("remove " + std::to_string(arrivalID));
+    removeAt(slot);
+    commitVersion(version() + 1);
+    return "Removed patient " + name;
+}
+
+template <class Scale>
+string PatientPriorityQueuex<Scale>::change(int arrivalID, int newPriority) {
+    int slot = arrivals.getSlotAtPlace(arrivalID);
+    if (slot == -1)
+        return "Patient with given id was not found.";
+
+    return changeAt(slot, newPriority);
+}
+
+template <class Scale>
+string PatientPriorityQueuex<Scale>::changeByName(const string& name,
+                                           int newPriority) {
+    vector<int> slots = names.find(name, data);
+    if (slots.empty())
+        return "Patient with given name was not found.";
+
+    if (slots.size() > 1) {
+        // Lists the arrival numbers so the user can pick one with change
+        std::stringstream ss;
+        ss << "Multiple patients are named " << name
+           << ", use change with one of the arrival numbers:";
+        for (int slot : slots) {
+            ss << " " << arrivals.getPlace(data[slot].getArrivalTime());
         }
+        return ss.str();
     }
 
-    data[0] = data[--heapSize];
-    data.pop_back();
-    if (heapSize > 1)
-        siftDown(0);
-}
-
-string PatientPriorityQueuex::change(int arrivalID, int newPriority) {
-    for (int i = 0; i < heapSize; i++) {
-        if (data[i].getArrivalTime() == arrivalID) {
-            Patient replacedCode(data[i].getName(), newPriority,
-                                 data[i].getPriorityCode());
-            data[i] = replacedCode;
-            return "Changed patient " + data[i].getName() +
-                   "'s priority to " + getPriorityString(data[i].getPriorityCode());
+    return changeAt(slots.front(), newPriority);
+}
+
+// Changes the priority of the patient at the given slot
+template <class Scale>
+string PatientPriorityQueuex<Scale>::changeAt(int slot, int newPriority) {
+    Patient changed = data[slot];
+    changed.setPriorityCode(newPriority);
+    recordCommand("change " +
+                  std::to_string(arrivals.getPlace(changed.getArrivalTime())) +
+                  " " +
+                  string(getPriorityString(newPriority)));
+    assign(slot, changed);
+
+    // The patient keeps their arrival time but may move either way
+    siftUp(slot);
+    siftDown(slot);
+    commitVersion(version() + 1);
+    return "Changed patient " + changed.getName() +
+           "'s priority to " + string(getPriorityString(newPriority));
+}
+
+// Removes the patient at the given slot and reorders the heap
+template <class Scale>
+void PatientPriorityQueuex<Scale>::removeAt(int slot) {
+    swapSlots(slot, heapSize - 1);
+    popSlot();
+
+    // The patient moved into the slot may belong above or below it
+    if (slot < heapSize) {
+        siftUp(slot);
+        siftDown(slot);
+    }
+}
+
+// Finds the patients with the given name, ignoring case
+template <class Scale>
+string PatientPriorityQueuex<Scale>::find(const string& name) const {
+    vector<int> slots = names.find(name, data);
+    if (slots.empty())
+        return "Patient with given name was not found.\n";
+
+    std::stringstream ss;
+    for (int slot : slots) {
+        ss << data[slot].getName() << ": arrival #"
+           << arrivals.getPlace(data[slot].getArrivalTime()) << ", "
+           << getPriorityString(data[slot].getPriorityCode());
+        if (slot == 0)
+            ss << ", next to be seen";
+        ss << "\n";
+    }
+    return ss.str();
+}
+
+// Returns the number of the current version of the queue
+template <class Scale>
+int PatientPriorityQueuex<Scale>::version() const {
+    return static_cast<int>(versionEnd.size()) - 1;
+}
+
+// Reverts the most recent change that has not already been undone
+template <class Scale>
+bool PatientPriorityQueuex<Scale>::undo() {
+    // An undo version has the same contents as an earlier version, so the
+    // change to revert is the one that produced that earlier version
+    int target = versionSame.back();
+    if (target == 0)
+        return false;
+
+    for (size_t i = versionEnd[target]; i > versionEnd[target - 1]; --i) {
+        revert(history[i - 1]);
+    }
+
+    // An unsaved change is simply forgotten, reverting a saved one can only
+    // be saved by exporting the whole queue
+    if (!unsaved.empty() && unsaved.back().first == target) {
+        while (!unsaved.empty() && unsaved.back().first == target) {
+            unsaved.pop_back();
         }
+    } else {
+        unsaved.clear();
+        unsavedReplayable = false;
     }
-    return "Patient with given id was not found.";
+    commitVersion(versionSame[target - 1]);
+    return true;
 }
 
 // Returns the current size of the priority queue
-int PatientPriorityQueuex::size() const {
+template <class Scale>
+int PatientPriorityQueuex<Scale>::size() const {
     return heapSize;
 }
 
 // Returns the name of the highest priority patient without removing them
-string PatientPriorityQueuex::peek() const {
+template <class Scale>
+string PatientPriorityQueuex<Scale>::peek() const {
     assert(heapSize != 0);
     return data.front().getName();
 }
 
 // Converts the priority queue to a formatted string for display
-string PatientPriorityQueuex::to_string() {
+template <class Scale>
+string PatientPriorityQueuex<Scale>::to_string() {
+    return listHeap(data);
+}
+
+// Converts the priority queue as it was at the given version to a string
+template <class Scale>
+string PatientPriorityQueuex<Scale>::to_string(int version) const {
+    assert(version >= 0 && version <= this->version());
+
+    // Starts from the first checkpoint at or after the version, or from the
+    // current heap when there is none
+    auto checkpoint = lower_bound(
+            checkpoints.begin(), checkpoints.end(), version,
+            [](const pair<int, vector<Patient>>& copy, int target) {
+                return copy.first < target;
+            });
+    vector<Patient> heap = checkpoint == checkpoints.end() ? data
+                                                           : checkpoint->second;
+    size_t end = checkpoint == checkpoints.end() ? history.size()
+                                                 : versionEnd[checkpoint->first];
+
+    // Rewinds the copy back to the end of the requested version
+    for (size_t i = end; i > versionEnd[version]; --i) {
+        revert(heap, history[i - 1]);
+    }
+    return listHeap(heap);
+}
+
+// Converts the wait time metrics of each priority code to a string
+template <class Scale>
+string PatientPriorityQueuex<Scale>::metrics() const {
     std::stringstream ss;
 
-    for (int i = 0; i < heapSize; ++i) {
-        ss << right << setw(7) << data[i].getArrivalTime() << "\t";
-        ss << left << "\t" << setw(13) << getPriorityString(data[i].getPriorityCode());
-        ss << setw(16) << data[i].getName();
-        if (i < heapSize - 1) {
+    ss << fixed << setprecision(3);
+    for (int code = 1; code <= Scale::LEVELS; ++code) {
+        ss << left << setw(LABEL_WIDTH) << getPriorityString(code);
+        ss << right << setw(8) << waitMetrics.count(code);
+        ss << setw(11) << waitMetrics.mean(code);
+        ss << setw(11) << waitMetrics.stddev(code);
+        ss << setw(11) << waitMetrics.percentile(code, 0.50);
+        ss << setw(11) << waitMetrics.percentile(code, 0.90);
+        ss << setw(11) << waitMetrics.percentile(code, 0.99) << "\n";
+    }
+
+    return ss.str();
+}
+
+// Converts a heap to a formatted string for display
+template <class Scale>
+string PatientPriorityQueuex<Scale>::listHeap(const vector<Patient>& heap) {
+    std::stringstream ss;
+    int count = static_cast<int>(heap.size());
+
+    // Arrival numbers are shown as places among the patients in the heap
+    vector<int> order;
+    order.reserve(count);
+    for (const Patient& patient : heap) {
+        order.push_back(patient.getArrivalTime());
+    }
+    sort(order.begin(), order.end());
+
+    for (int i = 0; i < count; ++i) {
+        int place = lower_bound(order.begin(), order.end(),
+                                heap[i].getArrivalTime()) - order.begin() + 1;
+        ss << right << setw(7) << place << "\t";
+        ss << left << "\t" << setw(LABEL_WIDTH) << getPriorityString(heap[i].getPriorityCode());
+        ss << setw(16) << heap[i].getName();
+        if (i < count - 1) {
             ss << "\n";
         }
     }
@@ -187,84 +614,201 @@ string PatientPriorityQueuex::to_string() {
     return ss.str();
 }
 
-string PatientPriorityQueuex::getPriorityString(int priority) {
-    vector<string> priorities = {"immediate", "emergency", "urgent", "minimal"};
-
-    return priorities[priority - 1];
+template <class Scale>
+string_view PatientPriorityQueuex<Scale>::getPriorityString(int priority) {
+    return getPriorityLabel<Scale>(priority);
 }
 
 // Moves the element at the given index up the heap to maintain heap property
-void PatientPriorityQueuex::siftUp(int index) {
+template <class Scale>
+void PatientPriorityQueuex<Scale>::siftUp(int index) {
     int parentIdx;
     if (index != 0) {
         parentIdx = getParent(index);
 
         // Overloaded operators for comparing patient objects
         if (data[parentIdx] > data[index]) {
-            swap(data[parentIdx], data[index]);
+            swapSlots(parentIdx, index);
             siftUp(parentIdx);
         }
     }
 }
 
 // Moves the element at the given index down the heap to maintain heap property
-void PatientPriorityQueuex::siftDown(int index) {
-    size_t leftIdx, rightIdx, maxIdx;
+template <class Scale>
+void PatientPriorityQueuex<Scale>::siftDown(int index) {
+    int leftIdx, rightIdx, maxIdx;
     leftIdx = getLeftChild(index);
     rightIdx = getRightChild(index);
 
-    if (rightIdx >= data.size()) {
-        if (leftIdx >= data.size())
+    if (rightIdx >= heapSize) {
+        if (leftIdx >= heapSize)
             return;
         else
             maxIdx = leftIdx;
     } else {
-        // Overloaded operators for comparing patient objects
+        // Overloaded operators for comparing patient objects, picks the
+        // child that is seen first
         if (data[leftIdx] > data[rightIdx])
-            maxIdx = leftIdx;
-        else
             maxIdx = rightIdx;
+        else
+            maxIdx = leftIdx;
     }
     // Overloaded operators for comparing patient objects
-    if (data[index] < data[maxIdx]) {
-        swap(data[maxIdx], data[index]);
+    if (data[index] > data[maxIdx]) {
+        swapSlots(maxIdx, index);
         siftDown(maxIdx);
     }
 }
 
+// Replaces the patient at the given slot
+template <class Scale>
+void PatientPriorityQueuex<Scale>::assign(int slot, Patient patient) {
+    history.push_back({Edit::Assign, slot,
+                       static_cast<int>(overwritten.size()), 0});
+    overwritten.push_back(data[slot]);
+    names.assign(slot, patient.getName());
+    data[slot] = patient;
+}
+
+// Exchanges the patients at the two given slots
+template <class Scale>
+void PatientPriorityQueuex<Scale>::swapSlots(int first, int second) {
+    history.push_back({Edit::Swap, first, second, 0});
+    swap(data[first], data[second]);
+    names.swap(first, second);
+    arrivals.swap(first, second);
+}
+
+// Appends a patient to the end of the heap
+template <class Scale>
+void PatientPriorityQueuex<Scale>::pushSlot(Patient patient) {
+    history.push_back({Edit::Push, 0, 0, 0});
+    names.push(patient.getName());
+    arrivals.push(patient.getArrivalTime());
+    data.push_back(std::move(patient));
+    heapSize++;
+}
+
+// Removes the last patient of the heap
+template <class Scale>
+void PatientPriorityQueuex<Scale>::popSlot() {
+    assert(heapSize != 0);
+    history.push_back({Edit::Pop, 0,
+                       static_cast<int>(overwritten.size()), 0});
+    overwritten.push_back(data.back());
+    names.pop();
+    arrivals.pop();
+    data.pop_back();
+    heapSize--;
+}
+
+// Records or retracts the wait of a seen patient in the metrics
+template <class Scale>
+void PatientPriorityQueuex<Scale>::serve(int priorityCode, chrono::nanoseconds wait,
+                                  int delta) {
+    history.push_back({Edit::Serve, priorityCode,
+                       static_cast<int>(waits.size()), delta});
+    waits.push_back(wait);
+    if (delta > 0)
+        waitMetrics.record(priorityCode, wait);
+    else
+        waitMetrics.retract(priorityCode, wait);
+}
+
+// Applies the opposite of a recorded write to the heap
+template <class Scale>
+void PatientPriorityQueuex<Scale>::revert(Edit edit) {
+    switch (edit.kind) {
+        case Edit::Assign:
+            assign(edit.first, overwritten[edit.second]);
+            break;
+        case Edit::Swap:
+            swapSlots(edit.first, edit.second);
+            break;
+        case Edit::Push:
+            popSlot();
+            break;
+        case Edit::Pop:
+            pushSlot(overwritten[edit.second]);
+            break;
+        case Edit::Serve:
+            serve(edit.first, waits[edit.second], -edit.delta);
+            break;
+    }
+}
+
+// Applies the opposite of a recorded write to a copy of the heap
+template <class Scale>
+void PatientPriorityQueuex<Scale>::revert(vector<Patient>& heap,
+                                   const Edit& edit) const {
+    switch (edit.kind) {
+        case Edit::Assign:
+            heap[edit.first] = overwritten[edit.second];
+            break;
+        case Edit::Swap:
+            swap(heap[edit.first], heap[edit.second]);
+            break;
+        case Edit::Push:
+            heap.pop_back();
+            break;
+        case Edit::Pop:
+            heap.push_back(overwritten[edit.second]);
+            break;
+        case Edit::Serve:
+            // Metrics are not part of the heap
+            break;
+    }
+}
+
+// Marks the end of the current version
+template <class Scale>
+void PatientPriorityQueuex<Scale>::commitVersion(int sameAs) {
+    versionEnd.push_back(history.size());
+    versionSame.push_back(sameAs);
+
+    // Bounds how far show has to rewind, while each copy of n patients is
+    // paid for by at least n writes
+    if (history.size() - checkpointEnd >= max<size_t>(1024, heapSize)) {
+        checkpoints.emplace_back(version(), data);
+        checkpointEnd = history.size();
+    }
+}
+
 // Returns the index of the parent of the object at the input index parameter
-int PatientPriorityQueuex::getParent(int index) {
+template <class Scale>
+int PatientPriorityQueuex<Scale>::getParent(int index) {
     return (index - 1) / 2;
 }
 
 // Returns the index of the left child for the input index parameter object
-int PatientPriorityQueuex::getLeftChild(int index) {
+template <class Scale>
+int PatientPriorityQueuex<Scale>::getLeftChild(int index) {
     return 2 * index + 1;
 }
 
 // Returns the index of the right child for the input index parameter object
-int PatientPriorityQueuex::getRightChild(int index) {
+template <class Scale>
+int PatientPriorityQueuex<Scale>::getRightChild(int index) {
     return 2 * index + 2;
 }
 
-vector<Patient> PatientPriorityQueuex::sortByArrival() {
+template <class Scale>
+vector<Patient> PatientPriorityQueuex<Scale>::sortByArrival() {
     // Create a copy of the data vector
     vector<Patient> copy = data;
 
-    // Bubble sort based on arrival times
-    for (int i = 0; i < heapSize - 1; ++i) {
-        for (int j = 0; j < heapSize - i - 1; ++j) {
-            if (copy[j].getArrivalTime() > copy[j + 1].getArrivalTime()) {
-                // Swap if the current element is greater than the next element
-                swap(copy[j], copy[j + 1]);
-            }
-        }
-    }
+    // Sort based on arrival times, which are unique
+    sort(copy.begin(), copy.end(),
+         [](const Patient& first, const Patient& second) {
+             return first.getArrivalTime() < second.getArrivalTime();
+         });
 
     return copy;
 }
 
-string PatientPriorityQueuex::save() {
+template <class Scale>
+string PatientPriorityQueuex<Scale>::save() {
     vector<Patient> copy = sortByArrival();
 
     // Create a formatted string for displaying the sorted data
@@ -282,4 +826,54 @@ string PatientPriorityQueuex::save() {
     // Return the formatted string
     return ss.str();
 }
+
+// Converts the changes made since the last save to commands
+template <class Scale>
+bool PatientPriorityQueuex<Scale>::saveChanges(const string& fileName,
+                                               long long fileBytes,
+                                               string& commands) const {
+    // Changes can only be appended to the file as it was last written
+    if (!unsavedReplayable || fileName != savedFile ||
+        fileBytes != savedFileBytes)
+        return false;
+
+    std::stringstream ss;
+    for (const pair<int, string>& change : unsaved) {
+        ss << change.second << "\n";
+    }
+    commands = ss.str();
+
+    long long deltaBytes = savedFileBytes - savedBaseBytes +
+                           static_cast<long long>(commands.length());
+    return deltaBytes <= max(MIN_COMPACT_BYTES, savedBaseBytes / 2);
+}
+
+// Marks the current queue as saved to the given file
+template <class Scale>
+void PatientPriorityQueuex<Scale>::markSaved(const string& fileName,
+                                             long long bytes, bool appended) {
+    if (appended) {
+        savedFileBytes += bytes;
+    } else {
+        savedFile = fileName;
+        savedBaseBytes = savedFileBytes = bytes;
+    }
+    unsaved.clear();
+    unsavedReplayable = true;
+}
+
+// Records the command that replays the change being made
+template <class Scale>
+void PatientPriorityQueuex<Scale>::recordCommand(const string& command) {
+    if (!unsavedReplayable)
+        return;
+
+    // Past this many commands, rewriting the whole queue is cheaper
+    if (unsaved.size() >= max<size_t>(1024, heapSize)) {
+        unsaved.clear();
+        unsavedReplayable = false;
+        return;
+    }
+    unsaved.emplace_back(version() + 1, command);
+}
 #endif //P3_PATIENTPRIORITYQUEUE_H
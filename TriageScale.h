@@ -0,0 +1,76 @@
+// AUTHOR:   Jacobie Fullerton
+// FILENAME: TriageScale.h
+// DATE:     11/11/2023
+// PURPOSE:  Defines the triage scales the queue and command parser can be
+//           built for. A scale lists the name of each priority code, most
+//           urgent first, and is chosen when compiling.
+// INPUT:    A priority code as an integer, or the name of a priority code.
+// PROCESS:  Looks the code or name up in the constant list of the scale.
+// OUTPUT:   The name of a priority code, or the code of a name.
+
+#ifndef P3_TRIAGESCALE_H
+#define P3_TRIAGESCALE_H
+
+#include <string_view>
+
+using namespace std;
+
+// The original four level scale
+struct FourLevelScale {
+    static constexpr int LEVELS = 4;
+    static constexpr string_view LABELS[LEVELS] = {
+            "immediate", "emergency", "urgent", "minimal"};
+};
+
+// The five level Emergency Severity Index
+struct EsiScale {
+    static constexpr int LEVELS = 5;
+    static constexpr string_view LABELS[LEVELS] = {
+            "resuscitation", "emergent", "urgent", "less-urgent",
+            "non-urgent"};
+};
+
+// Returns the name of a priority code of the scale
+// Precondition: 1 <= priorityCode <= Scale::LEVELS
+// Postcondition: Returns the name of the priority code
+template <class Scale>
+constexpr string_view getPriorityLabel(int priorityCode) {
+    return Scale::LABELS[priorityCode - 1];
+}
+
+// Returns the priority code of a name of the scale
+// Precondition: The name is in lower case
+// Postcondition: Returns the priority code, or -1 if the name is not part
+// of the scale
+template <class Scale>
+constexpr int parsePriorityLabel(string_view label) {
+    for (int i = 0; i < Scale::LEVELS; i++) {
+        if (Scale::LABELS[i] == label) {
+            return i + 1;
+        }
+    }
+    return -1;
+}
+
+// Returns the width of a column that fits every name of the scale followed
+// by a space, and is at least the given width
+// Precondition: none
+// Postcondition: Returns the column width
+template <class Scale>
+constexpr int getPriorityLabelWidth(int minimum) {
+    int width = minimum;
+    for (int i = 0; i < Scale::LEVELS; i++) {
+        if (static_cast<int>(Scale::LABELS[i].length()) + 1 > width) {
+            width = static_cast<int>(Scale::LABELS[i].length()) + 1;
+        }
+    }
+    return width;
+}
+
+static_assert(parsePriorityLabel<FourLevelScale>("urgent") == 3,
+              "four level scale names must round trip");
+static_assert(parsePriorityLabel<EsiScale>(
+                      getPriorityLabel<EsiScale>(5)) == 5,
+              "ESI scale names must round trip");
+
+#endif //P3_TRIAGESCALE_H
@@ -0,0 +1,192 @@
+// AUTHOR:   Jacobie Fullerton
+// FILENAME: WaitMetrics.h
+// DATE:     11/11/2023
+// PURPOSE:  Defines the WaitMetrics class, which keeps running wait time
+//           statistics for each priority code as patients are seen. The
+//           number of priority codes is fixed when compiling.
+// INPUT:    The priority code and wait time of each patient that is seen.
+// PROCESS:  Updates a count, mean and variance (Welford's method) and a
+//           histogram with logarithmic buckets for each priority code in
+//           constant time per patient.
+// OUTPUT:   Count, mean, standard deviation and percentiles of the waits.
+
+#ifndef P3_WAITMETRICS_H
+#define P3_WAITMETRICS_H
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+template <int LEVELS>
+class WaitMetrics {
+public:
+    // Adds a wait time to the statistics of a priority code
+    // Precondition: 1 <= priorityCode <= LEVELS
+    // Postcondition: The wait is included in the statistics
+    void record(int priorityCode, chrono::nanoseconds wait);
+
+    // Removes a wait time that was previously recorded
+    // Precondition: The same wait was recorded for the priority code
+    // Postcondition: The statistics are as if the wait was never recorded
+    void retract(int priorityCode, chrono::nanoseconds wait);
+
+    // Returns the number of patients seen with the priority code
+    // Precondition: 1 <= priorityCode <= LEVELS
+    // Postcondition: Returns the count
+    long long count(int priorityCode) const;
+
+    // Returns the mean wait in seconds of the priority code
+    // Precondition: 1 <= priorityCode <= LEVELS
+    // Postcondition: Returns the mean, or 0 if no patient was seen
+    double mean(int priorityCode) const;
+
+    // Returns the standard deviation of the waits in seconds
+    // Precondition: 1 <= priorityCode <= LEVELS
+    // Postcondition: Returns the sample standard deviation, or 0 if fewer
+    // than two patients were seen
+    double stddev(int priorityCode) const;
+
+    // Returns the wait in seconds that the given fraction of patients with
+    // the priority code did not exceed, within about 3% of the true value
+    // Precondition: 1 <= priorityCode <= LEVELS, 0 < fraction <= 1
+    // Postcondition: Returns the percentile, or 0 if no patient was seen
+    double percentile(int priorityCode, double fraction) const;
+
+private:
+    // Each power of two is split into 2^SUB_BITS buckets of equal width
+    static const int SUB_BITS = 4;
+    static const int SUB_BUCKETS = 1 << SUB_BITS;
+    static const int BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+    // Running statistics of a single priority code
+    struct Level {
+        long long count = 0;
+        double mean = 0;   // Mean wait in nanoseconds
+        double m2 = 0;     // Sum of squared distances from the mean
+        array<uint64_t, BUCKETS> buckets = {};
+    };
+
+    array<Level, LEVELS> levels;
+
+    // Returns the histogram bucket holding the given number of nanoseconds
+    // Precondition: none
+    // Postcondition: Returns an index less than BUCKETS
+    static int getBucket(uint64_t);
+
+    // Returns the middle of the range of nanoseconds held by a bucket
+    // Precondition: 0 <= bucket < BUCKETS
+    // Postcondition: Returns the midpoint in nanoseconds
+    static double getBucketMidpoint(int);
+};
+
+// Adds a wait time to the statistics of a priority code
+template <int LEVELS>
+void WaitMetrics<LEVELS>::record(int priorityCode, chrono::nanoseconds wait) {
+    Level &level = levels[priorityCode - 1];
+    uint64_t ns = wait.count() > 0 ? wait.count() : 0;
+    double delta = ns - level.mean;
+
+    level.count++;
+    level.mean += delta / level.count;
+    level.m2 += delta * (ns - level.mean);
+    level.buckets[getBucket(ns)]++;
+}
+
+// Removes a wait time that was previously recorded
+template <int LEVELS>
+void WaitMetrics<LEVELS>::retract(int priorityCode,
+                                  chrono::nanoseconds wait) {
+    Level &level = levels[priorityCode - 1];
+    uint64_t ns = wait.count() > 0 ? wait.count() : 0;
+    assert(level.count != 0);
+
+    if (level.count == 1) {
+        level.count = 0;
+        level.mean = 0;
+        level.m2 = 0;
+    } else {
+        // Runs the update of record() backwards
+        double oldMean = level.mean;
+        level.count--;
+        level.mean = (oldMean * (level.count + 1) - ns) / level.count;
+        level.m2 -= (ns - level.mean) * (ns - oldMean);
+        if (level.m2 < 0)
+            level.m2 = 0;
+    }
+    level.buckets[getBucket(ns)]--;
+}
+
+// Returns the number of patients seen with the priority code
+template <int LEVELS>
+long long WaitMetrics<LEVELS>::count(int priorityCode) const {
+    return levels[priorityCode - 1].count;
+}
+
+// Returns the mean wait in seconds of the priority code
+template <int LEVELS>
+double WaitMetrics<LEVELS>::mean(int priorityCode) const {
+    return levels[priorityCode - 1].mean / 1e9;
+}
+
+// Returns the standard deviation of the waits in seconds
+template <int LEVELS>
+double WaitMetrics<LEVELS>::stddev(int priorityCode) const {
+    const Level &level = levels[priorityCode - 1];
+    if (level.count < 2)
+        return 0;
+    return sqrt(level.m2 / (level.count - 1)) / 1e9;
+}
+
+// Returns the wait in seconds not exceeded by the given fraction of patients
+template <int LEVELS>
+double WaitMetrics<LEVELS>::percentile(int priorityCode,
+                                      double fraction) const {
+    const Level &level = levels[priorityCode - 1];
+    if (level.count == 0)
+        return 0;
+
+    // Walks the histogram until the rank of the percentile is reached
+    long long rank = (long long) ceil(fraction * level.count);
+    long long seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += level.buckets[i];
+        if (seen >= rank)
+            return getBucketMidpoint(i) / 1e9;
+    }
+    return getBucketMidpoint(BUCKETS - 1) / 1e9;
+}
+
+// Returns the histogram bucket holding the given number of nanoseconds
+template <int LEVELS>
+int WaitMetrics<LEVELS>::getBucket(uint64_t ns) {
+    if (ns < (uint64_t) SUB_BUCKETS)
+        return (int) ns;
+
+    // Finds the highest set bit with a binary search
+    int exponent = 0;
+    for (int step = 32; step > 0; step /= 2) {
+        if (ns >> (exponent + step))
+            exponent += step;
+    }
+
+    // The bits below the highest one select the bucket within its power
+    int shift = exponent - SUB_BITS;
+    return (shift + 1) * SUB_BUCKETS + (int) (ns >> shift) - SUB_BUCKETS;
+}
+
+// Returns the middle of the range of nanoseconds held by a bucket
+template <int LEVELS>
+double WaitMetrics<LEVELS>::getBucketMidpoint(int bucket) {
+    if (bucket < SUB_BUCKETS)
+        return bucket;
+
+    int shift = bucket / SUB_BUCKETS - 1;
+    double low = ldexp(bucket % SUB_BUCKETS + SUB_BUCKETS, shift);
+    return low + ldexp(1, shift) / 2;
+}
+
+#endif //P3_WAITMETRICS_H
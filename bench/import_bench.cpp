@@ -0,0 +1,74 @@
+// AUTHOR:   Jacobie Fullerton
+// FILENAME: import_bench.cpp
+// DATE:     11/11/2023
+// PURPOSE:  Times the parallel roster import with one thread up to the
+//           number of cores, so the speedup can be measured on any machine.
+// INPUT:    Optional number of roster lines and largest thread count.
+// PROCESS:  Builds a roster of add commands in memory, then for each thread
+//           count times parsing the roster and building the queue from it,
+//           keeping the best of several runs.
+// OUTPUT:   A table of parse, build and total times and the speedup of the
+//           total over a single thread.
+
+#define P3X_NO_MAIN
+#include "../p3x.cpp"
+
+#include <cstdlib>
+#include <random>
+
+// Builds the text of a roster file with the given number of add lines
+string makeRoster(int lines) {
+    mt19937 random(2023);
+    stringstream ss;
+    for (int i = 0; i < lines; i++) {
+        int code = 1 + random() % TriageScale::LEVELS;
+        ss << "add " << getPriorityLabel<TriageScale>(code) << " Patient "
+           << i << "\n";
+    }
+    return ss.str();
+}
+
+// Returns the seconds between two points in time
+double seconds(chrono::steady_clock::time_point from,
+               chrono::steady_clock::time_point to) {
+    return chrono::duration<double>(to - from).count();
+}
+
+int main(int argc, char *argv[]) {
+    const int RUNS = 3;
+    int lines = argc > 1 ? atoi(argv[1]) : 1000000;
+    int maxThreads = argc > 2 ? atoi(argv[2])
+                              : max(1u, thread::hardware_concurrency());
+
+    string text = makeRoster(lines);
+    cout << lines << " roster lines, " << text.size() << " bytes, "
+         << thread::hardware_concurrency() << " hardware threads\n";
+    cout << "Threads   Parse (s)   Build (s)   Total (s)   Speedup\n";
+
+    double singleThread = 0;
+    for (int threads = 1; threads <= maxThreads; threads++) {
+        double bestParse = 0, bestBuild = 0, bestTotal = 0;
+        for (int run = 0; run < RUNS; run++) {
+            TriageQueue priQueue;
+            chrono::steady_clock::time_point start = chrono::steady_clock::now();
+            vector<RosterChunk> chunks = parseRoster(text, threads);
+            chrono::steady_clock::time_point parsed = chrono::steady_clock::now();
+            addRoster(chunks, priQueue);
+            chrono::steady_clock::time_point built = chrono::steady_clock::now();
+
+            double total = seconds(start, built);
+            if (run == 0 || total < bestTotal) {
+                bestParse = seconds(start, parsed);
+                bestBuild = seconds(parsed, built);
+                bestTotal = total;
+            }
+        }
+        if (threads == 1)
+            singleThread = bestTotal;
+
+        cout << fixed << setprecision(3) << setw(7) << threads
+             << setw(12) << bestParse << setw(12) << bestBuild
+             << setw(12) << bestTotal << setw(9) << setprecision(2)
+             << singleThread / bestTotal << "x\n";
+    }
+}
@@ -0,0 +1,67 @@
+// AUTHOR:   Jacobie Fullerton
+// FILENAME: queue_bench.cpp
+// DATE:     11/11/2023
+// PURPOSE:  Times the queue operations for the triage scale the program is
+//           built for, so the scales can be compared on the same machine.
+// INPUT:    Optional number of patients.
+// PROCESS:  Adds patients with random priority codes, changes the priority
+//           of some, then sees every patient, keeping the best of several
+//           runs of each step.
+// OUTPUT:   A table of the time of each step and the time per patient.
+
+#define P3X_NO_MAIN
+#include "../p3x.cpp"
+
+#include <cstdlib>
+#include <random>
+
+// Returns the seconds between two points in time
+double seconds(chrono::steady_clock::time_point from,
+               chrono::steady_clock::time_point to) {
+    return chrono::duration<double>(to - from).count();
+}
+
+int main(int argc, char *argv[]) {
+    const int RUNS = 3;
+    int patients = argc > 1 ? atoi(argv[1]) : 200000;
+    int changes = patients / 10;
+
+    double bestAdd = 0, bestChange = 0, bestNext = 0;
+    for (int run = 0; run < RUNS; run++) {
+        mt19937 random(2023);
+        TriageQueue priQueue;
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 0; i < patients; i++) {
+            priQueue.add(Patient("Patient " + to_string(i),
+                                 1 + random() % TriageScale::LEVELS, 0));
+        }
+        chrono::steady_clock::time_point added = chrono::steady_clock::now();
+        for (int i = 0; i < changes; i++) {
+            priQueue.change(1 + random() % priQueue.size(),
+                            1 + random() % TriageScale::LEVELS);
+        }
+        chrono::steady_clock::time_point changed = chrono::steady_clock::now();
+        while (priQueue.size() > 0) {
+            priQueue.remove();
+        }
+        chrono::steady_clock::time_point seen = chrono::steady_clock::now();
+
+        if (run == 0 || seconds(start, seen) < bestAdd + bestChange + bestNext) {
+            bestAdd = seconds(start, added);
+            bestChange = seconds(added, changed);
+            bestNext = seconds(changed, seen);
+        }
+    }
+
+    cout << TriageScale::LEVELS << " level scale, " << patients
+         << " patients\n";
+    cout << "Step      Count   Time (s)   Per op (us)\n";
+    cout << fixed << setprecision(3)
+         << "add  " << setw(10) << patients << setw(11) << bestAdd
+         << setw(14) << bestAdd * 1e6 / patients << "\n"
+         << "change" << setw(9) << changes << setw(11) << bestChange
+         << setw(14) << (changes ? bestChange * 1e6 / changes : 0) << "\n"
+         << "next " << setw(10) << patients << setw(11) << bestNext
+         << setw(14) << bestNext * 1e6 / patients << "\n";
+}
@@ -5,16 +5,38 @@
 //           including user interactions and command processing.
 // INPUT:    User commands from the console or a file.
 // PROCESS:  Executes commands to manipulate the patient priority queue.
+//           Define TRIAGE_SCALE_ESI when compiling to use the five level
+//           Emergency Severity Index instead of the four level scale.
 // OUTPUT:   Displays information about patients and the triage system.
 
 #include "PatientPriorityQueuex.h"
-#include <array>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <system_error>
+#include <thread>
 
 using namespace std;
 
+// Triage scale the queue and command parser are built for
+#ifdef TRIAGE_SCALE_ESI
+using TriageScale = EsiScale;
+#else
+using TriageScale = FourLevelScale;
+#endif
+using TriageQueue = PatientPriorityQueuex<TriageScale>;
+
+// Add lines and errors parsed by one import thread from its part of a file
+struct RosterChunk {
+    size_t begin;                      // Offset of the first byte to parse
+    size_t end;                        // Offset one past the last byte
+    int lines = 0;                     // Number of lines in the chunk
+    vector<pair<int, string>> adds;    // Priority code and name of each add
+    vector<pair<int, string>> errors;  // Line within the chunk and message
+    bool otherCommand = false;         // A line other than add was found
+};
+
 // Function prototypes
 
 // Prints welcome message.
@@ -29,38 +51,99 @@ void help();
 // Process the line entered from the user or read from the file.
 // Precondition: Input is initiated and the line can be delimited
 // Postcondition: The patient is added to the priority queue.
-bool processLine(string, PatientPriorityQueuex &);
+bool processLine(string, TriageQueue &);
 
 // Adds the patient to the waiting room.
 // Precondition: The input string contains valid priority code / patient name.
 // Postcondition: The patient is added to the priority queue.
-void addPatientCmd(string, PatientPriorityQueuex &);
+void addPatientCmd(string, TriageQueue &);
 
 // Changes the priority code of the patient referenced by their arrival
 // Precondition: The input string contains valid priority code / patient name.
 // Postcondition: The patient's priority code is changed.
-void change(string, PatientPriorityQueuex &);
+void change(string, TriageQueue &);
+
+// Changes the priority code of the patient referenced by their name
+// Precondition: The input string contains patient name / valid priority code.
+// Postcondition: The patient's priority code is changed if the name is unique.
+void changeByNameCmd(string, TriageQueue &);
+
+// Displays the arrival number and priority code of patients with a name.
+// Precondition: The input string contains a patient name.
+// Postcondition: The matching patients are printed.
+void findPatientCmd(string, TriageQueue &);
 
 // Displays the next patient in the waiting room that will be called.
 // Precondition: The priority queue is not empty.
 // Postcondition: The highest priority patient is printed.
-void peekNextCmd(PatientPriorityQueuex &);
+void peekNextCmd(TriageQueue &);
 
 // Removes a patient from the waiting room and displays the name on the screen.
 // Precondition: The priority queue is not empty.
 // Postcondition: The highest priority patient is removed from the queue.
-void removePatientCmd(PatientPriorityQueuex &);
+void removePatientCmd(TriageQueue &);
+
+// Removes a patient referenced by their arrival without seeing them, as
+// saved files do to replay a next without adding to the metrics.
+// Precondition: The input string contains a patient id.
+// Postcondition: The patient is removed from the queue.
+void removeByArrivalCmd(string, TriageQueue &);
 
 // Displays the list of patients in the waiting room.
 // Precondition: The priority queue may be empty.
 // Postcondition: The list of patients is printed.
-void showPatientListCmd(PatientPriorityQueuex &);
+void showPatientListCmd(TriageQueue &);
+
+// Displays the wait time metrics of the patients seen so far.
+// Precondition: None
+// Postcondition: The metrics of each priority code are printed.
+void showMetricsCmd(TriageQueue &);
+
+// Displays the version number of the current state of the waiting room.
+// Precondition: None
+// Postcondition: The version number is printed.
+void snapshotCmd(TriageQueue &);
+
+// Reverts the most recent change to the waiting room.
+// Precondition: None
+// Postcondition: The queue is returned to its state before the last change.
+void undoCmd(TriageQueue &);
+
+// Displays the list of patients as it was at the given version.
+// Precondition: The input string has the form @<version>.
+// Postcondition: The list of patients at that version is printed.
+void showVersionCmd(string, TriageQueue &);
 
 // Reads a text file with each command on a separate line and executes the
 // lines as if they were typed into the command prompt.
 // Precondition: The file with the given filename exists.
 // Postcondition: The commands from the file are executed.
-void execCommandsFromFileCmd(string&, PatientPriorityQueuex &);
+void execCommandsFromFileCmd(string&, TriageQueue &);
+
+// Reads a roster file made up of add commands using several threads and
+// adds all of its patients in arrival order as a single change. The line
+// may start with --threads <count> to choose the number of threads.
+// Precondition: The file with the given filename exists.
+// Postcondition: The patients from the file are added to the queue.
+void importRosterCmd(string, TriageQueue &);
+
+// Splits the text of a roster file into newline aligned chunks and parses
+// each chunk on its own thread, or on the calling thread if no more threads
+// can be started.
+// Precondition: threads >= 1
+// Postcondition: Returns the parsed chunks in file order.
+vector<RosterChunk> parseRoster(const string&, size_t);
+
+// Prints the errors of parsed roster chunks with their line numbers and
+// adds their patients to the queue in file order.
+// Precondition: No chunk holds a command other than add.
+// Postcondition: Returns the number of patients added.
+size_t addRoster(vector<RosterChunk> &, TriageQueue &);
+
+// Parses the add commands of a newline aligned part of a roster file.
+// Precondition: The chunk starts at the beginning of a line.
+// Postcondition: The chunk holds the parsed patients and errors.
+void parseRosterChunk(const string&, RosterChunk &);
 
 // Delimits (by space) the string from user or file input.
 // Precondition: None
@@ -72,11 +155,15 @@ string delimitBySpace(string &);
 // Postcondition: Returns full lower case string.
 string toLower(const string&);
 
-// Saves the current patient queue to a file.
+// Saves the current patient queue to a file. When saving to the same file
+// again, only the commands for the changes since then are appended.
 // Precondition: None
 // Postcondition: Saves the patient queue at the file path given
-void save(string, PatientPriorityQueuex &);
+void save(string, TriageQueue &);
 
+// Other programs built from this file, such as the tests and benchmarks,
+// define P3X_NO_MAIN to provide their own main
+#ifndef P3X_NO_MAIN
 int main() {
     // declare variables
     string line;
@@ -85,7 +172,7 @@ int main() {
     welcome();
 
     // process commands
-    PatientPriorityQueuex priQueue;
+    TriageQueue priQueue;
 
     do {
         cout << "\ntriage> ";
@@ -96,9 +183,10 @@ int main() {
     // goodbye message
     goodbye();
 }
+#endif
 
 // Processes a line of input and executes the corresponding command
-bool processLine(string line, PatientPriorityQueuex &priQueue) {
+bool processLine(string line, TriageQueue &priQueue) {
     // get command
     string cmd = delimitBySpace(line);
     if (cmd.length() == 0) {
@@ -115,14 +203,30 @@ bool processLine(string line, PatientPriorityQueuex &priQueue) {
         addPatientCmd(line, priQueue);
     else if (cmd == "change")
         change(line, priQueue);
+    else if (cmd == "change-name")
+        changeByNameCmd(line, priQueue);
+    else if (cmd == "find")
+        findPatientCmd(line, priQueue);
     else if (cmd == "peek")
         peekNextCmd(priQueue);
     else if (cmd == "next")
         removePatientCmd(priQueue);
+    else if (cmd == "remove")
+        removeByArrivalCmd(line, priQueue);
     else if (cmd == "list")
         showPatientListCmd(priQueue);
+    else if (cmd == "metrics")
+        showMetricsCmd(priQueue);
+    else if (cmd == "snapshot")
+        snapshotCmd(priQueue);
+    else if (cmd == "undo")
+        undoCmd(priQueue);
+    else if (cmd == "show")
+        showVersionCmd(line, priQueue);
     else if (cmd == "load")
         execCommandsFromFileCmd(line, priQueue);
+    else if (cmd == "import")
+        importRosterCmd(line, priQueue);
     else if (cmd == "save")
         save(line, priQueue);
     else if (cmd == "quit")
@@ -145,8 +249,10 @@ string trim(const string& str) {
     return str.substr(start, end - start + 1);
 }
 
-// Parses input for the "add" command and extracts priority code and patient name
-bool parseAddPatientInput(string line, string &priority, string &name) {
+// Parses input for the "add" command and extracts priority code and patient
+// name, the reason is stored in error when the input is not valid
+bool parseAddPatientInput(string line, string &priority, string &name,
+                          string &error) {
     // Removes leading and trailing whitespace
     line = trim(line);
 
@@ -154,7 +260,7 @@ bool parseAddPatientInput(string line, string &priority, string &name) {
     priority = toLower(priority);
 
     if (priority.length() == 0) {
-        cout << "Error: no priority code given.\n";
+        error = "Error: no priority code given.\n";
         return false;
     }
 
@@ -162,31 +268,24 @@ bool parseAddPatientInput(string line, string &priority, string &name) {
     name = trim(name);
 
     if (name.length() == 0) {
-        cout << "Error: no patient name given.\n";
+        error = "Error: no patient name given.\n";
         return false;
     }
 
     return true;
 }
 
-// Maps priority codes to their corresponding index
-int getPriorityCode(string priority) {
-    array<string, 4> priorities = {"immediate", "emergency", "urgent", "minimal"};
-
-    for (int i = 0; i < 4; i++) {
-        if (priorities[i] == priority) {
-            return i + 1;
-        }
-    }
-
-    return -1; // Invalid priority code
+// Maps priority codes to their corresponding index, -1 if invalid
+int getPriorityCode(const string& priority) {
+    return parsePriorityLabel<TriageScale>(priority);
 }
 
 // Executes the "add" command to add a patient to the priority queue
-void addPatientCmd(string line, PatientPriorityQueuex &priQueue) {
+void addPatientCmd(string line, TriageQueue &priQueue) {
     // Parse input
-    string priority, name;
-    if (!parseAddPatientInput(line, priority, name)) {
+    string priority, name, error;
+    if (!parseAddPatientInput(line, priority, name, error)) {
+        cout << error;
         return; // Error occurred during input parsing
     }
 
@@ -202,7 +301,7 @@ void addPatientCmd(string line, PatientPriorityQueuex &priQueue) {
     cout << " Patient " + name + " added to the priority system\n";
 }
 
-void change(string line, PatientPriorityQueuex &priQueue) {
+void change(string line, TriageQueue &priQueue) {
     int arrivalID, priorityCode;
     stringstream ss;
 
@@ -226,8 +325,40 @@ void change(string line, PatientPriorityQueuex &priQueue) {
     cout << priQueue.change(arrivalID, priorityCode);
 }
 
+// Executes the "change-name" command to change a patient found by name
+void changeByNameCmd(string line, TriageQueue &priQueue) {
+    // The priority code is the last word, the name is everything before it
+    line = trim(line);
+    size_t pos = line.find_last_of(' ');
+    if (pos == string::npos) {
+        cout << "Error: patient name and priority code must both be given.\n";
+        return;
+    }
+
+    string name = trim(line.substr(0, pos));
+    int priorityCode = getPriorityCode(toLower(line.substr(pos + 1)));
+
+    if (priorityCode == -1) {
+        cout << "Error: invalid priority code.\n";
+        return;
+    }
+
+    cout << priQueue.changeByName(name, priorityCode);
+}
+
+// Executes the "find" command to display patients with the given name
+void findPatientCmd(string line, TriageQueue &priQueue) {
+    string name = trim(line);
+    if (name.length() == 0) {
+        cout << "Error: no patient name given.\n";
+        return;
+    }
+
+    cout << priQueue.find(name);
+}
+
 // Executes the "peek" command to display the next patient in line
-void peekNextCmd(PatientPriorityQueuex &priQueue) {
+void peekNextCmd(TriageQueue &priQueue) {
     // Check if queue is empty
     if (priQueue.size() == 0) {
         cout << "Queue is empty.\n";
@@ -239,7 +370,7 @@ void peekNextCmd(PatientPriorityQueuex &priQueue) {
 }
 
 // Executes the "next" command to remove the next patient from the queue
-void removePatientCmd(PatientPriorityQueuex &priQueue) {
+void removePatientCmd(TriageQueue &priQueue) {
     // Check if queue is empty
     if (priQueue.size() == 0) {
         cout << "Queue is empty.\n";
@@ -251,16 +382,79 @@ void removePatientCmd(PatientPriorityQueuex &priQueue) {
     priQueue.remove();
 }
 
+// Executes the "remove" command to remove a patient without seeing them
+void removeByArrivalCmd(string line, TriageQueue &priQueue) {
+    int arrivalID = 0;
+    stringstream ss;
+
+    line = trim(line);
+    if (line.length() == 0) {
+        cout << "Error: no patient id given.\n";
+        return;
+    }
+
+    ss << line;
+    ss >> arrivalID;
+    cout << priQueue.remove(arrivalID);
+}
+
 // Executes the "list" command to display the list of patients in the waiting room
-void showPatientListCmd(PatientPriorityQueuex &priQueue) {
+void showPatientListCmd(TriageQueue &priQueue) {
     cout << "# patients waiting: " << priQueue.size() << endl;
     cout << "  Arrival #   Priority Code   Patient Name\n"
          << "+-----------+---------------+--------------+\n";
     cout << priQueue.to_string();
 }
 
+// Executes the "metrics" command to display the waits of seen patients
+void showMetricsCmd(TriageQueue &priQueue) {
+    cout << "Wait times in seconds of patients seen so far\n";
+    cout << "Priority Code    Seen       Mean    Std Dev        p50"
+            "        p90        p99\n"
+         << "+-----------+-------+----------+----------+----------+"
+            "----------+----------+\n";
+    cout << priQueue.metrics();
+}
+
+// Executes the "snapshot" command to display the current version number
+void snapshotCmd(TriageQueue &priQueue) {
+    cout << "Current version: @" << priQueue.version() << endl;
+}
+
+// Executes the "undo" command to revert the most recent change
+void undoCmd(TriageQueue &priQueue) {
+    if (!priQueue.undo()) {
+        cout << "Nothing to undo.\n";
+        return;
+    }
+    cout << "Undid last change, now at version @" << priQueue.version() << endl;
+}
+
+// Executes the "show" command to display the queue at an earlier version
+void showVersionCmd(string line, TriageQueue &priQueue) {
+    int version;
+    stringstream ss;
+
+    line = trim(line);
+    if (line.length() < 2 || line[0] != '@') {
+        cout << "Error: version must be given as @<version>.\n";
+        return;
+    }
+
+    ss << line.substr(1);
+    if (!(ss >> version) || version < 0 || version > priQueue.version()) {
+        cout << "Error: version @" << line.substr(1) << " does not exist.\n";
+        return;
+    }
+
+    cout << "Version @" << version << endl;
+    cout << "  Arrival #   Priority Code   Patient Name\n"
+         << "+-----------+---------------+--------------+\n";
+    cout << priQueue.to_string(version);
+}
+
 // Executes the "load" command to read and execute commands from a file
-void execCommandsFromFileCmd(string& filename, PatientPriorityQueuex &priQueue) {
+void execCommandsFromFileCmd(string& filename, TriageQueue &priQueue) {
     ifstream infile;
     string line;
 
@@ -284,6 +478,169 @@ void execCommandsFromFileCmd(string& filename, PatientPriorityQueuex &priQueue)
     infile.close();
 }
 
+// Executes the "import" command to add a roster file of patients in parallel
+void importRosterCmd(string line, TriageQueue &priQueue) {
+    const size_t MIN_CHUNK = 1 << 16;
+    const size_t MAX_THREADS_PER_CORE = 64;
+    size_t threads = 0;
+
+    // An explicit thread count is used as given, for timing the import, as
+    // long as it stays within a sane multiple of the core count
+    line = trim(line);
+    if (line.compare(0, 10, "--threads ") == 0) {
+        size_t maxThreads = MAX_THREADS_PER_CORE *
+                            max(1u, thread::hardware_concurrency());
+        delimitBySpace(line);
+        stringstream ss(delimitBySpace(line));
+        long long count;
+        if (!(ss >> count) || count < 1 ||
+            static_cast<unsigned long long>(count) > maxThreads) {
+            cout << "Error: thread count must be between 1 and "
+                 << maxThreads << ".\n";
+            return;
+        }
+        threads = count;
+    }
+
+    // Reads the whole file so threads can parse it in place
+    string filename = trim(line);
+    ifstream infile(filename, ios::in | ios::binary);
+    if (!infile) {
+        cout << "Error: could not open file." << endl;
+        return;
+    }
+    string text((istreambuf_iterator<char>(infile)),
+                istreambuf_iterator<char>());
+    infile.close();
+
+    // By default each thread gets a chunk of at least MIN_CHUNK bytes
+    if (threads == 0) {
+        threads = max(1u, thread::hardware_concurrency());
+        threads = max<size_t>(1, min(threads, text.size() / MIN_CHUNK));
+    }
+
+    // Every thread gets at least one byte to parse
+    threads = max<size_t>(1, min(threads, text.size()));
+
+    vector<RosterChunk> chunks = parseRoster(text, threads);
+
+    // Anything but add lines has to run through the command processor
+    for (RosterChunk &chunk : chunks) {
+        if (chunk.otherCommand) {
+            cout << "Roster contains commands other than add, loading "
+                    "line by line.\n";
+            execCommandsFromFileCmd(filename, priQueue);
+            return;
+        }
+    }
+
+    size_t total = addRoster(chunks, priQueue);
+    cout << " " << total << " patients imported to the priority system using "
+         << threads << " thread(s)\n";
+}
+
+// Splits the text of a roster file into chunks parsed on their own threads
+vector<RosterChunk> parseRoster(const string& text, size_t threads) {
+    // Splits the file into one chunk per thread, each ending after a newline
+    vector<RosterChunk> chunks(threads);
+    size_t begin = 0;
+    for (size_t i = 0; i < threads; i++) {
+        size_t end = text.size() * (i + 1) / threads;
+        if (i + 1 < threads) {
+            end = text.find('\n', max(begin, end));
+            end = end == string::npos ? text.size() : end + 1;
+        }
+        chunks[i].begin = begin;
+        chunks[i].end = max(begin, end);
+        begin = chunks[i].end;
+    }
+
+    // Chunks that no thread could be started for are parsed on this one
+    vector<thread> workers;
+    size_t started = 1;
+    try {
+        for (; started < threads; started++) {
+            workers.emplace_back(parseRosterChunk, cref(text),
+                                 ref(chunks[started]));
+        }
+    } catch (const system_error&) {
+    }
+    for (size_t i = started; i < threads; i++) {
+        parseRosterChunk(text, chunks[i]);
+    }
+    parseRosterChunk(text, chunks[0]);
+    for (thread &worker : workers) {
+        worker.join();
+    }
+    return chunks;
+}
+
+// Adds the patients of parsed roster chunks to the queue in file order
+size_t addRoster(vector<RosterChunk> &chunks, TriageQueue &priQueue) {
+    // Arrival numbers follow the order of the lines in the file, exactly
+    // as if they had been added one at a time
+    size_t total = 0;
+    for (RosterChunk &chunk : chunks) {
+        total += chunk.adds.size();
+    }
+    vector<Patient> patients;
+    patients.reserve(total);
+
+    int lineOffset = 0;
+    int arrival = priQueue.size();
+    chrono::steady_clock::time_point now = chrono::steady_clock::now();
+    for (RosterChunk &chunk : chunks) {
+        for (pair<int, string> &error : chunk.errors) {
+            cout << "Line " << lineOffset + error.first << ": " << error.second;
+        }
+        for (pair<int, string> &add : chunk.adds) {
+            patients.emplace_back(move(add.second), add.first, ++arrival, now);
+        }
+        lineOffset += chunk.lines;
+    }
+
+    priQueue.addAll(patients);
+    return total;
+}
+
+// Parses the add commands of a newline aligned part of a roster file
+void parseRosterChunk(const string& text, RosterChunk &chunk) {
+    size_t pos = chunk.begin;
+    while (pos < chunk.end && !chunk.otherCommand) {
+        size_t end = text.find('\n', pos);
+        if (end == string::npos || end > chunk.end)
+            end = chunk.end;
+
+        string line = text.substr(pos, end - pos);
+        pos = end + 1;
+        chunk.lines++;
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        string cmd = delimitBySpace(line);
+        if (cmd.length() == 0 && trim(line).length() == 0)
+            continue;
+        if (toLower(cmd) != "add") {
+            chunk.otherCommand = true;
+            return;
+        }
+
+        string priority, name, error;
+        if (!parseAddPatientInput(line, priority, name, error)) {
+            chunk.errors.emplace_back(chunk.lines, error);
+            continue;
+        }
+
+        int priorityCode = getPriorityCode(priority);
+        if (priorityCode == -1) {
+            chunk.errors.emplace_back(chunk.lines,
+                                      "Error: invalid priority code.\n");
+            continue;
+        }
+        chunk.adds.emplace_back(priorityCode, move(name));
+    }
+}
+
 // Delimits (by space) the string from user or file input.
 string delimitBySpace(string &s) {
     const char SPACE = ' ';
@@ -301,7 +658,7 @@ string delimitBySpace(string &s) {
 
 
 // Saves all patients in the queue to a file
-void save(string fileName, PatientPriorityQueuex &priQueue) {
+void save(string fileName, TriageQueue &priQueue) {
     ofstream ofile;
 
     // Removes leading and trailing whitespace
@@ -311,8 +668,20 @@ void save(string fileName, PatientPriorityQueuex &priQueue) {
         return;
     }
 
+    // The queue decides whether its changes can be appended to the file
+    // as it is now
+    ifstream infile(fileName, ios::in | ios::binary | ios::ate);
+    long long fileBytes = infile ? static_cast<long long>(infile.tellg()) : -1;
+    infile.close();
+
+    string changes;
+    bool append = priQueue.saveChanges(fileName, fileBytes, changes);
+
     // Open the file
-    ofile.open(fileName, ios::out);
+    if (append)
+        ofile.open(fileName, ios::out | ios::binary | ios::app);
+    else
+        ofile.open(fileName, ios::out | ios::binary | ios::trunc);
 
     if (!ofile.is_open()) {
         cout << "Error: Unable to open the file.\n";
@@ -320,12 +689,19 @@ void save(string fileName, PatientPriorityQueuex &priQueue) {
     }
 
     // Write data to the file
-    ofile << priQueue.save();
+    string written = append ? changes : priQueue.save();
+    ofile << written;
 
     // Close the file
     ofile.close();
+    priQueue.markSaved(fileName, static_cast<long long>(written.length()),
+                       append);
 
-    cout << "File saved successfully.\n";
+    if (append)
+        cout << "Changes saved successfully (" << changes.length()
+             << " bytes appended).\n";
+    else
+        cout << "File saved successfully.\n";
 }
 
 // Converts a string to all lower case
@@ -354,19 +730,43 @@ void goodbye() {
 void help() {
 	cout << "add <priority-code> <patient-name>\n"
 << "            Adds the patient to the triage system.\n"
-<< "            <priority-code> must be one of the 4 accepted priority codes:\n"
-<< "                1. immediate 2. emergency 3. urgent 4. minimal\n"
+<< "            <priority-code> must be one of the " << TriageScale::LEVELS
+<< " accepted priority codes:\n"
+<< "               ";
+    for (int code = 1; code <= TriageScale::LEVELS; code++) {
+        cout << " " << code << ". " << getPriorityLabel<TriageScale>(code);
+    }
+    cout << "\n"
 << "            <patient-name>: patient's full legal name (may contain spaces)\n"
 << "change <arrival-number> <priority-code>\n"
 << "            Changes the patients priority code within the queue, but not\n"
 << "            their arrival number.\n"
+<< "change-name <patient-name> <priority-code>\n"
+<< "            Changes the priority code of the patient with the given name.\n"
+<< "            Use change instead when several patients share the name.\n"
+<< "find <patient-name>\n"
+<< "            Displays the arrival number and priority code of each patient\n"
+<< "            with the given name\n"
 << "next        Announces the patient to be seen next. Takes into account the\n"
 << "            type of emergency and the patient's arrival order.\n"
+<< "remove <arrival-number>\n"
+<< "            Removes the patient without seeing them or adding their wait\n"
+<< "            to the metrics. Saved files use it to replay next.\n"
 << "peek        Displays the patient that is next in line, but keeps in queue\n"
 << "list        Displays the list of all patients that are still waiting\n"
 << "            in the order that they have arrived.\n"
-<< "save <file> Saves the exporting the command for each patient\n"
+<< "metrics     Displays wait time statistics for each priority code of the\n"
+<< "            patients seen so far\n"
+<< "snapshot    Displays the version number of the current queue\n"
+<< "undo        Reverts the most recent change to the queue\n"
+<< "show @<version>\n"
+<< "            Displays the list of patients as it was at that version\n"
+<< "save <file> Saves the exporting the command for each patient. Saving to\n"
+<< "            the same file again appends only the changes since then\n"
 << "load <file> Reads the file and executes the command on each line\n"
+<< "import [--threads <count>] <file>\n"
+<< "            Adds every patient of a file of add commands at once, reading\n"
+<< "            the file with several threads\n"
 << "help        Displays this menu\n"
 << "quit        Exits the program\n";
 }
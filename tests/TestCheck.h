@@ -0,0 +1,38 @@
+// AUTHOR:   Jacobie Fullerton
+// FILENAME: TestCheck.h
+// DATE:     11/11/2023
+// PURPOSE:  Defines the check function shared by the test programs.
+// INPUT:    The result and description of each check.
+// PROCESS:  Counts the checks that failed.
+// OUTPUT:   Each failed check, and the exit code of the test program.
+
+#ifndef P3_TESTCHECK_H
+#define P3_TESTCHECK_H
+
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+int failures = 0;
+
+// Reports a failed check
+// Precondition: none
+// Postcondition: The failure is printed and counted
+void check(bool passed, const string& what) {
+    if (!passed) {
+        cout << "FAILED: " << what << "\n";
+        failures++;
+    }
+}
+
+// Prints the result of a test program
+// Precondition: none
+// Postcondition: Returns the exit code, 1 if any check failed
+int finish(const string& name) {
+    cout << name << ": "
+         << (failures == 0 ? "all checks passed" : "checks failed") << "\n";
+    return failures == 0 ? 0 : 1;
+}
+
+#endif //P3_TESTCHECK_H
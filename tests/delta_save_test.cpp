@@ -0,0 +1,130 @@
+// AUTHOR:   Jacobie Fullerton
+// FILENAME: delta_save_test.cpp
+// DATE:     11/11/2023
+// PURPOSE:  Checks that saving a queue again appends only its changes, and
+//           that loading the file rebuilds the same queue.
+// INPUT:    none
+// PROCESS:  Saves queues to a scratch file after several kinds of change,
+//           loads the file into a fresh queue and compares the two.
+// OUTPUT:   Each failed check, and an exit code of 1 if any check failed.
+
+#define P3X_NO_MAIN
+#include "../p3x.cpp"
+#include "TestCheck.h"
+
+#include <cstdio>
+
+const string FILE_NAME = "delta_save_test.txt";
+
+// Runs a command line on the queue and returns what it printed
+string run(const string& line, TriageQueue& priQueue) {
+    stringstream output;
+    streambuf *console = cout.rdbuf(output.rdbuf());
+    processLine(line, priQueue);
+    cout.rdbuf(console);
+    return output.str();
+}
+
+// Returns whether a save command appended to the file
+bool appended(const string& output) {
+    return output.find("Changes saved successfully") == 0;
+}
+
+// Returns the contents of the scratch file
+string readFile() {
+    ifstream infile(FILE_NAME, ios::in | ios::binary);
+    return string((istreambuf_iterator<char>(infile)),
+                  istreambuf_iterator<char>());
+}
+
+// Checks that loading the scratch file rebuilds the queue
+void checkReload(TriageQueue& priQueue, const string& what) {
+    TriageQueue loaded;
+    string output = run("load " + FILE_NAME, loaded);
+    check(loaded.save() == priQueue.save(), what + " reloads the same queue");
+    check(output.find("will now be seen") == string::npos,
+          what + " load announces no patients");
+    check(loaded.metrics() == TriageQueue().metrics(),
+          what + " load leaves the metrics empty");
+}
+
+// Checks that a full save followed by a delta of every kind of change
+// loads back into the same queue
+void testRoundTrip() {
+    string first(getPriorityLabel<TriageScale>(1));
+    string last(getPriorityLabel<TriageScale>(TriageScale::LEVELS));
+    TriageQueue priQueue;
+    run("add " + last + " Ada Lovelace", priQueue);
+    run("add " + last + " Grace Hopper", priQueue);
+    run("add " + first + " Alan Turing", priQueue);
+    run("add " + last + " Edsger Dijkstra", priQueue);
+    check(!appended(run("save " + FILE_NAME, priQueue)), "first save is full");
+    string base = readFile();
+
+    run("add " + first + " Barbara Liskov", priQueue);
+    run("next", priQueue);
+    run("change 2 " + first, priQueue);
+    run("change-name edsger dijkstra " + first, priQueue);
+    run("add " + last + " Undone Patient", priQueue);
+    run("undo", priQueue);
+    check(appended(run("save " + FILE_NAME, priQueue)),
+          "second save appends");
+    check(readFile().compare(0, base.size(), base) == 0,
+          "append keeps the full save");
+    check(readFile().find("Undone Patient") == string::npos,
+          "undone change is not saved");
+    checkReload(priQueue, "delta");
+
+    // Saving with nothing changed appends nothing
+    check(appended(run("save " + FILE_NAME, priQueue)), "empty delta appends");
+    checkReload(priQueue, "empty delta");
+}
+
+// Checks that the queue falls back to a full save whenever appending
+// would not rebuild it
+void testFullRewrites() {
+    TriageQueue priQueue;
+    for (int i = 0; i < 5; i++) {
+        run("add " + string(getPriorityLabel<TriageScale>(2)) + " Patient " +
+            std::to_string(i), priQueue);
+    }
+    run("save " + FILE_NAME, priQueue);
+
+    // Undoing a change that is already saved cannot be appended
+    run("next", priQueue);
+    check(appended(run("save " + FILE_NAME, priQueue)), "next appends");
+    run("undo", priQueue);
+    check(!appended(run("save " + FILE_NAME, priQueue)),
+          "undo of a saved change rewrites");
+    checkReload(priQueue, "undo of a saved change");
+
+    // The file was changed by something else since the last save
+    run("next", priQueue);
+    ofstream(FILE_NAME, ios::out | ios::binary | ios::app) << "\n";
+    check(!appended(run("save " + FILE_NAME, priQueue)),
+          "size mismatch rewrites");
+    checkReload(priQueue, "size mismatch");
+
+    // Saving to another file never appends to it
+    string changes;
+    run("next", priQueue);
+    check(!priQueue.saveChanges("other.txt", 0, changes),
+          "changes are not appended to another file");
+
+    // Changes larger than the compaction limit are written as a full save
+    string name(300, 'x');
+    for (int i = 0; i < 300; i++) {
+        run("add " + string(getPriorityLabel<TriageScale>(1)) + " " + name,
+            priQueue);
+    }
+    check(!appended(run("save " + FILE_NAME, priQueue)),
+          "large delta compacts");
+    checkReload(priQueue, "compacted save");
+}
+
+int main() {
+    testRoundTrip();
+    testFullRewrites();
+    std::remove(FILE_NAME.c_str());
+    return finish("delta save");
+}
@@ -0,0 +1,140 @@
+// AUTHOR:   Jacobie Fullerton
+// FILENAME: history_test.cpp
+// DATE:     11/11/2023
+// PURPOSE:  Checks the order patients are seen in, undo of every kind of
+//           change, and showing earlier versions of the queue.
+// INPUT:    none
+// PROCESS:  Runs random changes on a queue, keeping a copy of the display
+//           of every version, and compares undo and show against them.
+// OUTPUT:   Each failed check, and an exit code of 1 if any check failed.
+
+#define P3X_NO_MAIN
+#include "../p3x.cpp"
+#include "TestCheck.h"
+
+#include <random>
+
+// Returns the number of patients seen with a priority code, as shown in
+// the metrics table
+long long countSeen(const TriageQueue& priQueue, int code) {
+    stringstream rows(priQueue.metrics());
+    string row, label;
+    long long count = 0;
+    for (int i = 0; i < code; i++) {
+        getline(rows, row);
+    }
+    stringstream(row) >> label >> count;
+    return count;
+}
+
+// Checks that random patients are seen by priority code, then by arrival,
+// which needs sift down to pick the child that is seen first
+void testOrdering() {
+    mt19937 random(2023);
+    TriageQueue priQueue;
+    vector<pair<int, int>> expected; // Priority code and arrival of each
+    for (int arrival = 1; arrival <= 2000; arrival++) {
+        int code = 1 + random() % TriageScale::LEVELS;
+        priQueue.add(Patient(std::to_string(arrival), code, 0));
+        expected.emplace_back(code, arrival);
+    }
+    sort(expected.begin(), expected.end());
+
+    int wrong = 0;
+    for (const pair<int, int>& patient : expected) {
+        if (priQueue.peek() != std::to_string(patient.second))
+            wrong++;
+        priQueue.remove();
+    }
+    check(wrong == 0, std::to_string(wrong) + " patients seen out of order");
+}
+
+// Checks that undo reverts an add, next, change and import, and takes the
+// wait of an undone next back out of the metrics
+void testUndo() {
+    TriageQueue priQueue;
+    vector<string> shown = {priQueue.to_string()};
+
+    priQueue.add(Patient("Ada", TriageScale::LEVELS, 0));
+    shown.push_back(priQueue.to_string());
+    priQueue.add(Patient("Grace", 2, 0));
+    shown.push_back(priQueue.to_string());
+    priQueue.change(1, 1);
+    shown.push_back(priQueue.to_string());
+
+    vector<Patient> roster = {Patient("Alan", 1, 0), Patient("Edsger", 2, 0),
+                              Patient("Barbara", TriageScale::LEVELS, 0)};
+    priQueue.addAll(roster);
+    shown.push_back(priQueue.to_string());
+
+    priQueue.remove();
+    check(countSeen(priQueue, 1) == 1, "next adds a wait to the metrics");
+
+    // Each undo returns to the version before the change it reverts
+    check(priQueue.undo(), "undo next");
+    check(countSeen(priQueue, 1) == 0, "undo of next retracts the wait");
+    check(priQueue.to_string() == shown[4], "undo next restores the queue");
+    check(priQueue.undo() && priQueue.size() == 2 &&
+          priQueue.to_string() == shown[3], "undo import");
+    check(priQueue.undo() && priQueue.to_string() == shown[2], "undo change");
+    check(priQueue.undo() && priQueue.to_string() == shown[1], "undo add");
+    check(priQueue.undo() && priQueue.size() == 0, "undo first add");
+    check(!priQueue.undo(), "nothing left to undo");
+
+    // Undos are versions of their own, so earlier versions stay available
+    check(priQueue.version() == 10, "undo creates versions");
+    for (int version = 0; version < static_cast<int>(shown.size());
+         version++) {
+        check(priQueue.to_string(version) == shown[version],
+              "show @" + std::to_string(version) + " after undo");
+    }
+}
+
+// Checks that every version shows as it was, including versions before
+// several checkpoints, which are taken after every 1024 writes or more
+void testShowAcrossCheckpoints() {
+    mt19937 random(7);
+    TriageQueue priQueue;
+    vector<string> shown = {priQueue.to_string()};
+
+    for (int step = 0; step < 4000; step++) {
+        int action = random() % 10;
+        if (action < 4 || priQueue.size() < 8) {
+            priQueue.add(Patient("Patient " + std::to_string(step),
+                                 1 + random() % TriageScale::LEVELS, 0));
+        } else if (action < 7) {
+            priQueue.remove();
+        } else if (action < 9) {
+            priQueue.change(1 + random() % priQueue.size(),
+                            1 + random() % TriageScale::LEVELS);
+        } else {
+            priQueue.undo();
+        }
+
+        // An undo with nothing left to revert makes no version
+        if (static_cast<int>(shown.size()) <= priQueue.version())
+            shown.push_back(priQueue.to_string());
+
+        // Keeps the queue small so each version is cheap to keep
+        while (priQueue.size() > 48) {
+            priQueue.remove();
+            shown.push_back(priQueue.to_string());
+        }
+    }
+
+    check(static_cast<int>(shown.size()) == priQueue.version() + 1,
+          "one display kept per version");
+    int wrong = 0;
+    for (int version = 0; version <= priQueue.version(); version++) {
+        if (priQueue.to_string(version) != shown[version])
+            wrong++;
+    }
+    check(wrong == 0, std::to_string(wrong) + " versions shown wrongly");
+}
+
+int main() {
+    testOrdering();
+    testUndo();
+    testShowAcrossCheckpoints();
+    return finish("history");
+}
@@ -0,0 +1,203 @@
+// AUTHOR:   Jacobie Fullerton
+// FILENAME: name_index_test.cpp
+// DATE:     11/11/2023
+// PURPOSE:  Checks the index of patient names, on its own and through the
+//           find and change-name commands of the queue.
+// INPUT:    none
+// PROCESS:  Builds queues with many patients sharing a name and compares
+//           what the index finds with a search of every patient.
+// OUTPUT:   Each failed check, and an exit code of 1 if any check failed.
+
+#define P3X_NO_MAIN
+#include "../p3x.cpp"
+#include "TestCheck.h"
+
+// Returns the slots of the patients with the name, by searching them all
+vector<int> searchAll(const vector<Patient>& heap, const string& name) {
+    vector<int> slots;
+    for (int slot = 0; slot < static_cast<int>(heap.size()); slot++) {
+        if (toLower(heap[slot].getName()) == toLower(name))
+            slots.push_back(slot);
+    }
+    return slots;
+}
+
+// Returns the slots the index finds for a name, in ascending order
+vector<int> findSorted(const NameIndex& names, const vector<Patient>& heap,
+                       const string& name) {
+    vector<int> slots = names.find(name, heap);
+    sort(slots.begin(), slots.end());
+    return slots;
+}
+
+// Returns the number of lines in a string
+int countLines(const string& text) {
+    return static_cast<int>(count(text.begin(), text.end(), '\n'));
+}
+
+// Checks that slots sharing a name stay indexed through every kind of write
+void testSharedNames() {
+    NameIndex names;
+    vector<Patient> heap;
+    const string NAMES[] = {"Unknown Patient", "UNKNOWN PATIENT", "Ada"};
+
+    for (int i = 0; i < 300; i++) {
+        heap.push_back(Patient(NAMES[i % 3], 1, i));
+        names.push(NAMES[i % 3]);
+    }
+
+    // Swaps within and across names, renames and pops, as sifting does
+    for (int i = 0; i < 1000; i++) {
+        int first = (i * 7) % heap.size();
+        int second = (i * 13 + 5) % heap.size();
+        swap(heap[first], heap[second]);
+        names.swap(first, second);
+        if (i % 10 == 0) {
+            heap[first] = Patient(NAMES[(i / 10) % 3], 1, i);
+            names.assign(first, heap[first].getName());
+        }
+        if (i % 25 == 0) {
+            heap.pop_back();
+            names.pop();
+        }
+    }
+
+    for (const char *name : {"unknown patient", "ADA", "Nobody"}) {
+        check(findSorted(names, heap, name) == searchAll(heap, name),
+              "index matches search for " + string(name));
+    }
+
+    // Emptying the index leaves nothing to find
+    while (!heap.empty()) {
+        heap.pop_back();
+        names.pop();
+    }
+    check(names.find("Ada", heap).empty(), "empty index finds nothing");
+}
+
+// Checks that removing names from the middle of probe runs keeps every
+// other name reachable, as cells are shifted back into the gaps
+void testEraseKeepsRunsReachable() {
+    const int PATIENTS = 4000;
+    NameIndex names;
+    vector<Patient> heap;
+    for (int i = 0; i < PATIENTS; i++) {
+        heap.push_back(Patient("Patient " + std::to_string(i), 1, i));
+        names.push(heap.back().getName());
+    }
+
+    // Renames every third slot, which removes its old name from the table
+    for (int slot = 0; slot < PATIENTS; slot += 3) {
+        heap[slot] = Patient("Renamed " + std::to_string(slot), 1, slot);
+        names.assign(slot, heap[slot].getName());
+    }
+
+    int lost = 0;
+    for (int slot = 0; slot < PATIENTS; slot++) {
+        if (findSorted(names, heap, heap[slot].getName()) != vector<int>{slot})
+            lost++;
+        if (slot % 3 == 0 &&
+            !names.find("Patient " + std::to_string(slot), heap).empty())
+            lost++;
+    }
+    check(lost == 0, std::to_string(lost) + " names wrong after erase");
+}
+
+// Checks find and change-name through the queue, ignoring case and
+// listing the arrival numbers when several patients share the name
+void testFindAndChangeName() {
+    string first(getPriorityLabel<TriageScale>(1));
+    string second(getPriorityLabel<TriageScale>(2));
+    string last(getPriorityLabel<TriageScale>(TriageScale::LEVELS));
+    TriageQueue priQueue;
+    priQueue.add(Patient("Ada Lovelace", TriageScale::LEVELS, 0));
+    priQueue.add(Patient("Grace Hopper", TriageScale::LEVELS, 0));
+    priQueue.add(Patient("ada lovelace", TriageScale::LEVELS, 0));
+    priQueue.add(Patient("Alan Turing", 1, 0));
+
+    check(priQueue.find("GRACE HOPPER") ==
+          "Grace Hopper: arrival #2, " + last + "\n", "find ignores case");
+    check(priQueue.find("Alan Turing") ==
+          "Alan Turing: arrival #4, " + first + ", next to be seen\n",
+          "find marks the next patient");
+    check(priQueue.find("Nobody") == "Patient with given name was not found.\n",
+          "find unknown name");
+
+    string ambiguous = priQueue.changeByName("ADA LOVELACE", 2);
+    check(ambiguous.find("Multiple patients are named ADA LOVELACE") == 0,
+          "change-name with a shared name is refused");
+    check(ambiguous.find(" 1") != string::npos &&
+          ambiguous.find(" 3") != string::npos, "ambiguity lists arrivals");
+    check(countLines(priQueue.find("ada lovelace")) == 2,
+          "find lists every patient sharing a name");
+
+    // The change moves Grace up the heap, and the index follows her
+    check(priQueue.changeByName("grace hopper", 2) ==
+          "Changed patient Grace Hopper's priority to " + second,
+          "change-name ignores case");
+    check(priQueue.find("Grace Hopper") ==
+          "Grace Hopper: arrival #2, " + second + "\n", "find after change");
+
+    // Seeing Alan moves the last patient to the top and sifts it down
+    priQueue.remove();
+    check(priQueue.find("alan turing") ==
+          "Patient with given name was not found.\n", "find after next");
+    check(priQueue.find("Grace Hopper") ==
+          "Grace Hopper: arrival #2, " + second + ", next to be seen\n",
+          "find after next sifts");
+    string shared = priQueue.find("Ada Lovelace");
+    check(shared.find("Ada Lovelace: arrival #1, " + last + "\n") !=
+          string::npos &&
+          shared.find("ada lovelace: arrival #3, " + last + "\n") !=
+          string::npos, "arrival numbers after next");
+
+    // Undoing the next and the change restores what the index finds
+    priQueue.undo();
+    check(priQueue.find("ALAN TURING") ==
+          "Alan Turing: arrival #4, " + first + ", next to be seen\n",
+          "find after undo of next");
+    priQueue.undo();
+    check(priQueue.find("Grace Hopper") ==
+          "Grace Hopper: arrival #2, " + last + "\n",
+          "find after undo of change");
+    check(priQueue.changeByName("Nobody", 1) ==
+          "Patient with given name was not found.", "change-name unknown");
+}
+
+// Checks that a roster of placeholder names is indexed and seen quickly,
+// as every patient sharing one name used to make each heap write linear
+void testManyDuplicateNames() {
+    const int PATIENTS = 50000;
+    TriageQueue priQueue;
+
+    vector<Patient> roster;
+    for (int i = 0; i < PATIENTS; i++) {
+        roster.push_back(Patient("Unknown Patient", 1 + i % TriageScale::LEVELS,
+                                 0));
+    }
+    roster.push_back(Patient("Ada Lovelace", TriageScale::LEVELS, 0));
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    priQueue.addAll(roster);
+    for (int i = 0; i < PATIENTS / 2; i++) {
+        priQueue.remove();
+    }
+    priQueue.change(1, 1);
+    double seconds = chrono::duration<double>(
+            chrono::steady_clock::now() - start).count();
+
+    check(countLines(priQueue.find("unknown patient")) ==
+          priQueue.size() - 1, "duplicates found after next");
+    check(countLines(priQueue.find("ADA LOVELACE")) == 1,
+          "unique name found among duplicates");
+    check(seconds < 5, "duplicate names took " + std::to_string(seconds) +
+                       " s");
+}
+
+int main() {
+    testSharedNames();
+    testEraseKeepsRunsReachable();
+    testFindAndChangeName();
+    testManyDuplicateNames();
+    return finish("name index");
+}
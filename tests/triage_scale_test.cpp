@@ -0,0 +1,125 @@
+// AUTHOR:   Jacobie Fullerton
+// FILENAME: triage_scale_test.cpp
+// DATE:     11/11/2023
+// PURPOSE:  Checks the command parser and the queue for the triage scale the
+//           program is built for. Built once for each scale.
+// INPUT:    none
+// PROCESS:  Parses every name of the scale, adds patients of every priority
+//           code and sees them, and captures the metrics and help output.
+// OUTPUT:   Each failed check, and an exit code of 1 if any check failed.
+
+#define P3X_NO_MAIN
+#include "../p3x.cpp"
+#include "TestCheck.h"
+
+// Checks that every name of the scale parses to its code and back
+void testParse() {
+    for (int code = 1; code <= TriageScale::LEVELS; code++) {
+        string label(getPriorityLabel<TriageScale>(code));
+        check(getPriorityCode(label) == code, "parse " + label);
+
+        // Names are accepted in any case by the add command
+        string upper = label;
+        transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+        string priority, name, error;
+        check(parseAddPatientInput(upper + "  Ada  Lovelace ", priority, name,
+                                   error), "parse add " + upper);
+        check(getPriorityCode(priority) == code, "parse upper " + upper);
+        check(name == "Ada  Lovelace", "parse name with " + upper);
+    }
+
+    check(getPriorityCode("") == -1, "parse empty name");
+    check(getPriorityCode("critical") == -1, "parse unknown name");
+    check(getPriorityCode(to_string(1)) == -1, "parse number as name");
+
+    string priority, name, error;
+    check(!parseAddPatientInput("   ", priority, name, error) &&
+          !error.empty(), "parse add without priority code");
+}
+
+// Checks that patients are seen by priority code, then by arrival
+void testOrdering() {
+    TriageQueue priQueue;
+
+    // Adds two patients of each code, least urgent first
+    for (int round = 0; round < 2; round++) {
+        for (int code = TriageScale::LEVELS; code >= 1; code--) {
+            priQueue.add(Patient(to_string(code) + "-" + to_string(round),
+                                 code, 0));
+        }
+    }
+    check(priQueue.size() == 2 * TriageScale::LEVELS, "size after adds");
+
+    for (int code = 1; code <= TriageScale::LEVELS; code++) {
+        for (int round = 0; round < 2; round++) {
+            string expected = to_string(code) + "-" + to_string(round);
+            check(priQueue.peek() == expected, "seen order " + expected);
+            priQueue.remove();
+        }
+    }
+    check(priQueue.size() == 0, "size after next");
+}
+
+// Checks that the metrics have one row per code, labelled by the scale
+void testMetrics() {
+    TriageQueue priQueue;
+    for (int code = 1; code <= TriageScale::LEVELS; code++) {
+        for (int i = 0; i < code; i++) {
+            priQueue.add(Patient("Patient", code, 0));
+        }
+    }
+    while (priQueue.size() > 0) {
+        priQueue.remove();
+    }
+
+    // Removing without seeing, as a saved next is replayed, is not counted
+    priQueue.add(Patient("Replayed", 1, 0));
+    priQueue.remove(1);
+    check(priQueue.size() == 0, "remove by arrival");
+
+    stringstream rows(priQueue.metrics());
+    string row;
+    int code = 0;
+    while (getline(rows, row)) {
+        code++;
+        if (code > TriageScale::LEVELS)
+            break;
+
+        stringstream fields(row);
+        string label;
+        long long count = 0;
+        fields >> label >> count;
+        check(label == getPriorityLabel<TriageScale>(code),
+              "metrics label of row " + to_string(code));
+        check(count == code, "metrics count of row " + to_string(code));
+    }
+    check(code == TriageScale::LEVELS, "metrics row count");
+}
+
+// Checks that the help lists the number of codes and every name
+void testHelp() {
+    stringstream output;
+    streambuf *console = cout.rdbuf(output.rdbuf());
+    help();
+    cout.rdbuf(console);
+
+    string text = output.str();
+    check(text.find("one of the " + to_string(TriageScale::LEVELS) +
+                    " accepted") != string::npos, "help code count");
+    for (int code = 1; code <= TriageScale::LEVELS; code++) {
+        string entry = to_string(code) + ". " +
+                       string(getPriorityLabel<TriageScale>(code));
+        check(text.find(entry) != string::npos, "help lists " + entry);
+    }
+    check(text.find(to_string(TriageScale::LEVELS + 1) + ". ") ==
+          string::npos, "help lists no extra codes");
+}
+
+int main() {
+    testParse();
+    testOrdering();
+    testMetrics();
+    testHelp();
+
+    return finish(to_string(TriageScale::LEVELS) + " level scale");
+}